@@ -0,0 +1,19 @@
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "zsystem::zsystem" for configuration ""
+set_property(TARGET zsystem::zsystem APPEND PROPERTY IMPORTED_CONFIGURATIONS NOCONFIG)
+set_target_properties(zsystem::zsystem PROPERTIES
+  IMPORTED_LOCATION_NOCONFIG "${_IMPORT_PREFIX}/lib/libzsystem.so"
+  IMPORTED_SONAME_NOCONFIG "libzsystem.so"
+  )
+
+list(APPEND _cmake_import_check_targets zsystem::zsystem )
+list(APPEND _cmake_import_check_files_for_zsystem::zsystem "${_IMPORT_PREFIX}/lib/libzsystem.so" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,118 @@
+# Generated by CMake
+
+if("${CMAKE_MAJOR_VERSION}.${CMAKE_MINOR_VERSION}" LESS 2.8)
+   message(FATAL_ERROR "CMake >= 2.8.0 required")
+endif()
+if(CMAKE_VERSION VERSION_LESS "2.8.3")
+   message(FATAL_ERROR "CMake >= 2.8.3 required")
+endif()
+cmake_policy(PUSH)
+cmake_policy(VERSION 2.8.3...3.23)
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Protect against multiple inclusion, which would fail when already imported targets are added once more.
+set(_cmake_targets_defined "")
+set(_cmake_targets_not_defined "")
+set(_cmake_expected_targets "")
+foreach(_cmake_expected_target IN ITEMS zsystem::zsystem)
+  list(APPEND _cmake_expected_targets "${_cmake_expected_target}")
+  if(TARGET "${_cmake_expected_target}")
+    list(APPEND _cmake_targets_defined "${_cmake_expected_target}")
+  else()
+    list(APPEND _cmake_targets_not_defined "${_cmake_expected_target}")
+  endif()
+endforeach()
+unset(_cmake_expected_target)
+if(_cmake_targets_defined STREQUAL _cmake_expected_targets)
+  unset(_cmake_targets_defined)
+  unset(_cmake_targets_not_defined)
+  unset(_cmake_expected_targets)
+  unset(CMAKE_IMPORT_FILE_VERSION)
+  cmake_policy(POP)
+  return()
+endif()
+if(NOT _cmake_targets_defined STREQUAL "")
+  string(REPLACE ";" ", " _cmake_targets_defined_text "${_cmake_targets_defined}")
+  string(REPLACE ";" ", " _cmake_targets_not_defined_text "${_cmake_targets_not_defined}")
+  message(FATAL_ERROR "Some (but not all) targets in this export set were already defined.\nTargets Defined: ${_cmake_targets_defined_text}\nTargets not yet defined: ${_cmake_targets_not_defined_text}\n")
+endif()
+unset(_cmake_targets_defined)
+unset(_cmake_targets_not_defined)
+unset(_cmake_expected_targets)
+
+
+# Compute the installation prefix relative to this file.
+get_filename_component(_IMPORT_PREFIX "${CMAKE_CURRENT_LIST_FILE}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+if(_IMPORT_PREFIX STREQUAL "/")
+  set(_IMPORT_PREFIX "")
+endif()
+
+# Create imported target zsystem::zsystem
+add_library(zsystem::zsystem SHARED IMPORTED)
+
+set_target_properties(zsystem::zsystem PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "ZSYSTEM_PMR"
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_LINK_LIBRARIES "Threads::Threads"
+)
+
+if(NOT CMAKE_VERSION VERSION_LESS "3.23.0")
+  target_sources(zsystem::zsystem
+    INTERFACE
+      FILE_SET "HEADERS"
+      TYPE "HEADERS"
+      BASE_DIRS "${_IMPORT_PREFIX}/include"
+      FILES "${_IMPORT_PREFIX}/include/zsystem/Backtrace.h" "${_IMPORT_PREFIX}/include/zsystem/ConcurrencyController.h" "${_IMPORT_PREFIX}/include/zsystem/CoprocessPool.h" "${_IMPORT_PREFIX}/include/zsystem/Logger.h" "${_IMPORT_PREFIX}/include/zsystem/MemoryResource.h" "${_IMPORT_PREFIX}/include/zsystem/Process.h" "${_IMPORT_PREFIX}/include/zsystem/ProcessCache.h" "${_IMPORT_PREFIX}/include/zsystem/ProcessKey.h" "${_IMPORT_PREFIX}/include/zsystem/Reaper.h" "${_IMPORT_PREFIX}/include/zsystem/Sha256.h" "${_IMPORT_PREFIX}/include/zsystem/ShardedProcess.h" "${_IMPORT_PREFIX}/include/zsystem/SharedMemory.h" "${_IMPORT_PREFIX}/include/zsystem/Signal.h" "${_IMPORT_PREFIX}/include/zsystem/SignalHandler.h" "${_IMPORT_PREFIX}/include/zsystem/SingleFlight.h" "${_IMPORT_PREFIX}/include/zsystem/Supervisor.h" "${_IMPORT_PREFIX}/include/zsystem/process/Arguments.h" "${_IMPORT_PREFIX}/include/zsystem/process/BufferPool.h" "${_IMPORT_PREFIX}/include/zsystem/process/Consumer.h" "${_IMPORT_PREFIX}/include/zsystem/process/ConsumerBatch.h" "${_IMPORT_PREFIX}/include/zsystem/process/ConsumerBudget.h" "${_IMPORT_PREFIX}/include/zsystem/process/ConsumerFeeder.h" "${_IMPORT_PREFIX}/include/zsystem/process/ConsumerFile.h" "${_IMPORT_PREFIX}/include/zsystem/process/ConsumerSpan.h" "${_IMPORT_PREFIX}/include/zsystem/process/ConsumerString.h" "${_IMPORT_PREFIX}/include/zsystem/process/Environment.h" "${_IMPORT_PREFIX}/include/zsystem/process/Feature.h" "${_IMPORT_PREFIX}/include/zsystem/process/FeatureProcess.h" "${_IMPORT_PREFIX}/include/zsystem/process/FeatureThrottle.h" "${_IMPORT_PREFIX}/include/zsystem/process/FeatureTime.h" "${_IMPORT_PREFIX}/include/zsystem/process/FeatureTimeout.h" "${_IMPORT_PREFIX}/include/zsystem/process/FileDescriptor.h" "${_IMPORT_PREFIX}/include/zsystem/process/Producer.h" "${_IMPORT_PREFIX}/include/zsystem/process/ProducerDynamic.h" "${_IMPORT_PREFIX}/include/zsystem/process/ProducerFile.h" "${_IMPORT_PREFIX}/include/zsystem/process/ProducerIovec.h" "${_IMPORT_PREFIX}/include/zsystem/process/ProducerStatic.h" "${_IMPORT_PREFIX}/include/zsystem/process/StaticStream.h" "${_IMPORT_PREFIX}/include/zsystem/process/TimerWheel.h"
+  )
+endif()
+
+if(CMAKE_VERSION VERSION_LESS 2.8.12)
+  message(FATAL_ERROR "This file relies on consumers using CMake 2.8.12 or greater.")
+endif()
+
+# Load information for each installed configuration.
+file(GLOB _cmake_config_files "${CMAKE_CURRENT_LIST_DIR}/zsystemTargets-*.cmake")
+foreach(_cmake_config_file IN LISTS _cmake_config_files)
+  include("${_cmake_config_file}")
+endforeach()
+unset(_cmake_config_file)
+unset(_cmake_config_files)
+
+# Cleanup temporary variables.
+set(_IMPORT_PREFIX)
+
+# Loop over all imported files and verify that they actually exist
+foreach(_cmake_target IN LISTS _cmake_import_check_targets)
+  foreach(_cmake_file IN LISTS "_cmake_import_check_files_for_${_cmake_target}")
+    if(NOT EXISTS "${_cmake_file}")
+      message(FATAL_ERROR "The imported target \"${_cmake_target}\" references the file
+   \"${_cmake_file}\"
+but this file does not exist.  Possible reasons include:
+* The file was deleted, renamed, or moved to another location.
+* An install or uninstall procedure did not complete successfully.
+* The installation package was faulty and contained
+   \"${CMAKE_CURRENT_LIST_FILE}\"
+but not all the files it references.
+")
+    endif()
+  endforeach()
+  unset(_cmake_file)
+  unset("_cmake_import_check_files_for_${_cmake_target}")
+endforeach()
+unset(_cmake_target)
+unset(_cmake_import_check_targets)
+
+# This file does not depend on other imported targets which have
+# been exported from the same project but in a separate export set.
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+cmake_policy(POP)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "Benchmarkzsystem"
+  "Benchmarkzsystem.pdb"
+  "CMakeFiles/Benchmarkzsystem.dir/main.cpp.o"
+  "CMakeFiles/Benchmarkzsystem.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Benchmarkzsystem.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,51 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/main/zsystem/Backtrace.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/Backtrace.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/Backtrace.cpp.o.d"
+  "/root/repo/src/main/zsystem/ConcurrencyController.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/ConcurrencyController.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/ConcurrencyController.cpp.o.d"
+  "/root/repo/src/main/zsystem/CoprocessPool.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/CoprocessPool.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/CoprocessPool.cpp.o.d"
+  "/root/repo/src/main/zsystem/Process.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/Process.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/Process.cpp.o.d"
+  "/root/repo/src/main/zsystem/ProcessCache.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/ProcessCache.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/ProcessCache.cpp.o.d"
+  "/root/repo/src/main/zsystem/ProcessKey.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/ProcessKey.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/ProcessKey.cpp.o.d"
+  "/root/repo/src/main/zsystem/Reaper.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/Reaper.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/Reaper.cpp.o.d"
+  "/root/repo/src/main/zsystem/Sha256.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/Sha256.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/Sha256.cpp.o.d"
+  "/root/repo/src/main/zsystem/ShardedProcess.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/ShardedProcess.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/ShardedProcess.cpp.o.d"
+  "/root/repo/src/main/zsystem/SharedMemory.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/SharedMemory.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/SharedMemory.cpp.o.d"
+  "/root/repo/src/main/zsystem/Signal.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/Signal.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/Signal.cpp.o.d"
+  "/root/repo/src/main/zsystem/SignalHandler.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/SignalHandler.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/SignalHandler.cpp.o.d"
+  "/root/repo/src/main/zsystem/SingleFlight.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/SingleFlight.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/SingleFlight.cpp.o.d"
+  "/root/repo/src/main/zsystem/Supervisor.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/Supervisor.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/Supervisor.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/Arguments.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/Arguments.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/Arguments.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/BufferPool.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/BufferPool.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/BufferPool.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ConsumerBatch.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerBatch.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerBatch.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ConsumerBudget.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerBudget.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerBudget.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ConsumerFeeder.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerFeeder.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerFeeder.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ConsumerFile.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerFile.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerFile.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ConsumerSpan.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerSpan.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerSpan.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ConsumerString.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerString.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ConsumerString.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/Environment.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/Environment.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/Environment.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/FeatureProcess.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureProcess.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureProcess.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/FeatureThrottle.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureThrottle.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureThrottle.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/FeatureTime.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureTime.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureTime.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/FeatureTimeout.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureTimeout.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FeatureTimeout.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/FileDescriptor.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FileDescriptor.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/FileDescriptor.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ProducerDynamic.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerDynamic.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerDynamic.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ProducerFile.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerFile.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerFile.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ProducerIovec.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerIovec.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerIovec.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/ProducerStatic.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerStatic.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/ProducerStatic.cpp.o.d"
+  "/root/repo/src/main/zsystem/process/TimerWheel.cpp" "src/main/CMakeFiles/zsystem.dir/zsystem/process/TimerWheel.cpp.o" "gcc" "src/main/CMakeFiles/zsystem.dir/zsystem/process/TimerWheel.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,75 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zsystem.dir/zsystem/Backtrace.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/Backtrace.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/ConcurrencyController.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/ConcurrencyController.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/CoprocessPool.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/CoprocessPool.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/Process.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/Process.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/ProcessCache.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/ProcessCache.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/ProcessKey.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/ProcessKey.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/Reaper.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/Reaper.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/Sha256.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/Sha256.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/ShardedProcess.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/ShardedProcess.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/SharedMemory.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/SharedMemory.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/Signal.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/Signal.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/SignalHandler.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/SignalHandler.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/SingleFlight.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/SingleFlight.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/Supervisor.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/Supervisor.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/Arguments.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/Arguments.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/BufferPool.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/BufferPool.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerBatch.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerBatch.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerBudget.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerBudget.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerFeeder.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerFeeder.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerFile.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerFile.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerSpan.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerSpan.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerString.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ConsumerString.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/Environment.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/Environment.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureProcess.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureProcess.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureThrottle.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureThrottle.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureTime.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureTime.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureTimeout.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/FeatureTimeout.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/FileDescriptor.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/FileDescriptor.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerDynamic.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerDynamic.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerFile.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerFile.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerIovec.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerIovec.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerStatic.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/ProducerStatic.cpp.o.d"
+  "CMakeFiles/zsystem.dir/zsystem/process/TimerWheel.cpp.o"
+  "CMakeFiles/zsystem.dir/zsystem/process/TimerWheel.cpp.o.d"
+  "libzsystem.pdb"
+  "libzsystem.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zsystem.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,109 @@
+# Install script for directory: /root/repo/src/main
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libzsystem.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libzsystem.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libzsystem.so"
+         RPATH "")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_pmr_build/src/main/libzsystem.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libzsystem.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libzsystem.so")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libzsystem.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/zsystem" TYPE FILE FILES
+    "/root/repo/src/main/zsystem/Backtrace.h"
+    "/root/repo/src/main/zsystem/ConcurrencyController.h"
+    "/root/repo/src/main/zsystem/CoprocessPool.h"
+    "/root/repo/src/main/zsystem/Logger.h"
+    "/root/repo/src/main/zsystem/MemoryResource.h"
+    "/root/repo/src/main/zsystem/Process.h"
+    "/root/repo/src/main/zsystem/ProcessCache.h"
+    "/root/repo/src/main/zsystem/ProcessKey.h"
+    "/root/repo/src/main/zsystem/Reaper.h"
+    "/root/repo/src/main/zsystem/Sha256.h"
+    "/root/repo/src/main/zsystem/ShardedProcess.h"
+    "/root/repo/src/main/zsystem/SharedMemory.h"
+    "/root/repo/src/main/zsystem/Signal.h"
+    "/root/repo/src/main/zsystem/SignalHandler.h"
+    "/root/repo/src/main/zsystem/SingleFlight.h"
+    "/root/repo/src/main/zsystem/Supervisor.h"
+    )
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/zsystem/process" TYPE FILE FILES
+    "/root/repo/src/main/zsystem/process/Arguments.h"
+    "/root/repo/src/main/zsystem/process/BufferPool.h"
+    "/root/repo/src/main/zsystem/process/Consumer.h"
+    "/root/repo/src/main/zsystem/process/ConsumerBatch.h"
+    "/root/repo/src/main/zsystem/process/ConsumerBudget.h"
+    "/root/repo/src/main/zsystem/process/ConsumerFeeder.h"
+    "/root/repo/src/main/zsystem/process/ConsumerFile.h"
+    "/root/repo/src/main/zsystem/process/ConsumerSpan.h"
+    "/root/repo/src/main/zsystem/process/ConsumerString.h"
+    "/root/repo/src/main/zsystem/process/Environment.h"
+    "/root/repo/src/main/zsystem/process/Feature.h"
+    "/root/repo/src/main/zsystem/process/FeatureProcess.h"
+    "/root/repo/src/main/zsystem/process/FeatureThrottle.h"
+    "/root/repo/src/main/zsystem/process/FeatureTime.h"
+    "/root/repo/src/main/zsystem/process/FeatureTimeout.h"
+    "/root/repo/src/main/zsystem/process/FileDescriptor.h"
+    "/root/repo/src/main/zsystem/process/Producer.h"
+    "/root/repo/src/main/zsystem/process/ProducerDynamic.h"
+    "/root/repo/src/main/zsystem/process/ProducerFile.h"
+    "/root/repo/src/main/zsystem/process/ProducerIovec.h"
+    "/root/repo/src/main/zsystem/process/ProducerStatic.h"
+    "/root/repo/src/main/zsystem/process/StaticStream.h"
+    "/root/repo/src/main/zsystem/process/TimerWheel.h"
+    )
+endif()
+
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Testzsystem.dir/main.cpp.o"
+  "CMakeFiles/Testzsystem.dir/main.cpp.o.d"
+  "Testzsystem"
+  "Testzsystem.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Testzsystem.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,422 @@
+#include <zsystem/Process.h>
+#include <zsystem/Reaper.h>
+#include <zsystem/process/Arguments.h>
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/ConsumerFile.h>
+#include <zsystem/process/ConsumerSpan.h>
+#include <zsystem/process/FileDescriptor.h>
+#include <zsystem/process/ProducerDynamic.h>
+#include <zsystem/process/ProducerStatic.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+using namespace zsystem;
+using namespace zsystem::process;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double percentile(const std::vector<double>& sortedValues, double p) {
+	if(sortedValues.empty()) {
+		return 0.0;
+	}
+	std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sortedValues.size() - 1) + 0.5);
+	return sortedValues[index];
+}
+
+}
+
+void printBenchmark_spawn() {
+	std::cout <<
+			"  spawn [max-threads] [ms-per-step]\n"
+			"     Execute \"/usr/bin/true\" as often as possible by 1, 2, 4, ... max-threads threads (default: 64)\n"
+			"     for ms-per-step milliseconds (default: 2000) per step.\n"
+			"     - Close stdin.\n"
+			"     - Close stdout.\n"
+			"     - Not closing stderr.\n"
+			"     Result:\n"
+			"     - Spawns per second and latency percentiles of Process::execute per number of threads.\n"
+			"\n";
+}
+
+void printBenchmark_spawnReaper() {
+	std::cout <<
+			"  spawn-reaper [max-threads] [ms-per-step]\n"
+			"     Same as \"spawn\", but children are reaped by a Reaper.\n"
+			"\n";
+}
+
+void printBenchmark_stream() {
+	std::cout <<
+			"  stream [mib] [record-size]\n"
+			"     Write mib MiB (default: 256) in records of record-size bytes (default: 64) to \"/usr/bin/cat\"\n"
+			"     and read its stdout.\n"
+			"     - virtual: ProducerDynamic with a std::function and a ConsumerSpan, called by virtual functions.\n"
+			"     - static:  Process::executeStatic with lambdas, the loop is instantiated for them.\n"
+			"     Both variants read adaptive chunks (see ChunkSize), so they differ in the dispatch only.\n"
+			"     Result:\n"
+			"     - Throughput in MiB/s of both variants.\n"
+			"\n";
+}
+
+void printBenchmark_throughput() {
+	std::cout <<
+			"  throughput [mib]\n"
+			"     Write mib MiB (default: 1024) to \"/usr/bin/cat\" and read its stdout.\n"
+			"     - 4k:      Producer and Consumer move 4096 bytes per syscall, the former fixed size.\n"
+			"     - default: ProducerDynamic and a ConsumerSpan with adaptive chunks, kernel default pipe capacity.\n"
+			"     - max:     the same with pipes raised to /proc/sys/fs/pipe-max-size by Process::setStreamBufferSize.\n"
+			"     Result:\n"
+			"     - Throughput in MiB/s and read/write syscalls of this process per GiB (from /proc/self/io).\n"
+			"\n";
+}
+
+void printBenchmark_vmsplice() {
+	std::cout <<
+			"  vmsplice [mib]\n"
+			"     Write mib MiB (default: 1024) from memory by ProducerStatic to \"/usr/bin/cat\", its stdout is /dev/null.\n"
+			"     Both with stdin raised to /proc/sys/fs/pipe-max-size.\n"
+			"     - write:    the data is copied into the pipe.\n"
+			"     - vmsplice: ProducerStatic::setZeroCopy(true), the pages are mapped into the pipe.\n"
+			"     Result:\n"
+			"     - Throughput in MiB/s and CPU time of this process per GiB, that is the time spent on copying.\n"
+			"\n";
+}
+
+void printUsage() {
+	std::cout <<
+			"zsystem benchmark\n"
+			"\n";
+	printBenchmark_spawn();
+	printBenchmark_spawnReaper();
+	printBenchmark_stream();
+	printBenchmark_throughput();
+	printBenchmark_vmsplice();
+}
+
+void runSpawn(std::size_t maxThreads, std::chrono::milliseconds duration) {
+	std::cout << std::setw(8) << "threads"
+			<< std::setw(10) << "spawns"
+			<< std::setw(12) << "spawns/s"
+			<< std::setw(12) << "p50 [us]"
+			<< std::setw(12) << "p90 [us]"
+			<< std::setw(12) << "p99 [us]"
+			<< std::setw(12) << "p99.9 [us]"
+			<< std::setw(12) << "max [us]"
+			<< "\n";
+
+	for(std::size_t threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+		std::vector<std::vector<double>> latencies(threadCount);
+		std::vector<std::thread> threads;
+
+		Clock::time_point start = Clock::now();
+		Clock::time_point end = start + duration;
+
+		for(std::size_t i = 0; i < threadCount; ++i) {
+			std::vector<double>& threadLatencies = latencies[i];
+			threadLatencies.reserve(100000);
+
+			threads.emplace_back([&threadLatencies, end]() {
+				while(Clock::now() < end) {
+					Clock::time_point spawnStart = Clock::now();
+
+					Process process(Arguments("/usr/bin/true"));
+					process.execute(FileDescriptor::stdErrHandle);
+
+					std::chrono::duration<double, std::micro> latency = Clock::now() - spawnStart;
+					threadLatencies.push_back(latency.count());
+				}
+			});
+		}
+		for(auto& thread : threads) {
+			thread.join();
+		}
+		std::chrono::duration<double> elapsed = Clock::now() - start;
+
+		std::vector<double> allLatencies;
+		for(const auto& threadLatencies : latencies) {
+			allLatencies.insert(allLatencies.end(), threadLatencies.begin(), threadLatencies.end());
+		}
+		std::sort(allLatencies.begin(), allLatencies.end());
+
+		std::cout << std::fixed << std::setprecision(0)
+				<< std::setw(8) << threadCount
+				<< std::setw(10) << allLatencies.size()
+				<< std::setw(12) << (static_cast<double>(allLatencies.size()) / elapsed.count())
+				<< std::setw(12) << percentile(allLatencies, 0.5)
+				<< std::setw(12) << percentile(allLatencies, 0.9)
+				<< std::setw(12) << percentile(allLatencies, 0.99)
+				<< std::setw(12) << percentile(allLatencies, 0.999)
+				<< std::setw(12) << (allLatencies.empty() ? 0.0 : allLatencies.back())
+				<< "\n";
+	}
+}
+
+/* produces records of recordSize bytes until size bytes are produced */
+class RecordSource {
+public:
+	RecordSource(std::size_t aSize, std::size_t aRecordSize)
+	: size(aSize),
+	  record(aRecordSize, 'x')
+	{
+		record.back() = '\n';
+	}
+
+	std::size_t operator()(char* data, std::size_t dataSize) {
+		std::size_t count = 0;
+		while(pos < size && dataSize - count >= record.size()) {
+			std::memcpy(data + count, record.data(), record.size());
+			count += record.size();
+			pos += record.size();
+		}
+		return count;
+	}
+
+private:
+	std::size_t size;
+	std::size_t pos = 0;
+	std::string record;
+};
+
+class CountingConsumer : public Consumer {
+public:
+	bool consume(FileDescriptor& fileDescriptor) override {
+		char buffer[4096];
+		std::size_t count = fileDescriptor.read(buffer, sizeof(buffer));
+		if(count == FileDescriptor::npos) {
+			return false;
+		}
+		if(count != FileDescriptor::wouldBlock) {
+			bytes += count;
+		}
+		return true;
+	}
+
+	std::size_t bytes = 0;
+};
+
+class SpanCountingConsumer : public ConsumerSpan {
+public:
+	bool consumeData(const char*, std::size_t size) override {
+		bytes += size;
+		return true;
+	}
+
+	std::size_t bytes = 0;
+};
+
+void runStream(std::size_t mib, std::size_t recordSize) {
+	std::size_t size = mib * 1024 * 1024;
+
+	{
+		RecordSource source(size, recordSize);
+		ProducerDynamic producer([&source](char* data, std::size_t dataSize) { return source(data, dataSize); });
+		/* reads adaptive chunks like the static variant, so only the dispatch differs */
+		SpanCountingConsumer consumer;
+
+		Clock::time_point start = Clock::now();
+		Process process(Arguments("/usr/bin/cat"));
+		process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+		std::chrono::duration<double> elapsed = Clock::now() - start;
+
+		std::cout << std::fixed << std::setprecision(0)
+				<< std::setw(8) << "virtual"
+				<< std::setw(12) << (static_cast<double>(consumer.bytes) / (1024 * 1024) / elapsed.count()) << " MiB/s\n";
+	}
+
+	{
+		std::size_t bytes = 0;
+
+		Clock::time_point start = Clock::now();
+		Process process(Arguments("/usr/bin/cat"));
+		process.executeStatic(RecordSource(size, recordSize), [&bytes](const char*, std::size_t count) {
+			bytes += count;
+			return true;
+		});
+		std::chrono::duration<double> elapsed = Clock::now() - start;
+
+		std::cout << std::fixed << std::setprecision(0)
+				<< std::setw(8) << "static"
+				<< std::setw(12) << (static_cast<double>(bytes) / (1024 * 1024) / elapsed.count()) << " MiB/s\n";
+	}
+}
+
+/* returns syscr + syscw of this process */
+std::size_t getReadWriteSyscalls() {
+	std::ifstream io("/proc/self/io");
+	std::string key;
+	std::size_t value;
+	std::size_t syscalls = 0;
+	while(io >> key >> value) {
+		if(key == "syscr:" || key == "syscw:") {
+			syscalls += value;
+		}
+	}
+	return syscalls;
+}
+
+/* writes size bytes in chunks of 4096 bytes per syscall */
+class Producer4k : public Producer {
+public:
+	Producer4k(std::size_t aSize)
+	: size(aSize)
+	{ }
+
+	std::size_t produce(FileDescriptor& fileDescriptor) override {
+		if(pos >= size) {
+			return FileDescriptor::npos;
+		}
+		std::size_t count = fileDescriptor.write(buffer, std::min(sizeof(buffer), size - pos));
+		if(count == FileDescriptor::wouldBlock) {
+			return 0;
+		}
+		if(count == FileDescriptor::npos) {
+			return FileDescriptor::npos;
+		}
+		pos += count;
+		return count;
+	}
+
+private:
+	std::size_t size;
+	std::size_t pos = 0;
+	char buffer[4096] = {};
+};
+
+void runThroughput(std::size_t mib) {
+	std::size_t size = mib * 1024 * 1024;
+	const char* names[] = { "4k", "default", "max" };
+
+	std::cout << std::setw(8) << "variant" << std::setw(12) << "MiB/s" << std::setw(16) << "syscalls/GiB" << "\n";
+	for(int variant = 0; variant < 3; ++variant) {
+		Process process(Arguments("/usr/bin/cat"));
+		if(variant == 2) {
+			process.setStreamBufferSize(FileDescriptor::stdInHandle, FileDescriptor::getPipeMaxSize());
+			process.setStreamBufferSize(FileDescriptor::stdOutHandle, FileDescriptor::getPipeMaxSize());
+		}
+
+		std::size_t bytes = 0;
+		std::size_t syscalls = getReadWriteSyscalls();
+		Clock::time_point start = Clock::now();
+
+		if(variant == 0) {
+			Producer4k producer(size);
+			CountingConsumer consumer;
+			process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+			bytes = consumer.bytes;
+		}
+		else {
+			std::size_t pos = 0;
+			ProducerDynamic producer([&pos, size](char*, std::size_t dataSize) {
+				dataSize = std::min(dataSize, size - pos);
+				pos += dataSize;
+				return dataSize;
+			});
+			SpanCountingConsumer consumer;
+			process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+			bytes = consumer.bytes;
+		}
+
+		std::chrono::duration<double> elapsed = Clock::now() - start;
+		syscalls = getReadWriteSyscalls() - syscalls;
+
+		double gib = static_cast<double>(bytes) / (1024 * 1024 * 1024);
+		std::cout << std::fixed << std::setprecision(0)
+				<< std::setw(8) << names[variant]
+				<< std::setw(12) << (static_cast<double>(bytes) / (1024 * 1024) / elapsed.count())
+				<< std::setw(16) << (gib > 0 ? static_cast<double>(syscalls) / gib : 0.0) << "\n";
+	}
+}
+
+/* returns user and system CPU time of this process, without children */
+double getCpuSeconds() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+			+ static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+}
+
+void runVmsplice(std::size_t mib) {
+	std::string input(mib * 1024 * 1024, 'x');
+	const char* names[] = { "write", "vmsplice" };
+
+	std::cout << std::setw(8) << "variant" << std::setw(12) << "MiB/s" << std::setw(16) << "CPU ms/GiB" << "\n";
+	for(int variant = 0; variant < 2; ++variant) {
+		ProducerStatic producer(input.data(), input.size());
+		producer.setZeroCopy(variant == 1);
+		ConsumerFile consumer(FileDescriptor::openFile("/dev/null", false, true, false));
+
+		Process process(Arguments("/usr/bin/cat"));
+		process.setStreamBufferSize(FileDescriptor::stdInHandle, FileDescriptor::getPipeMaxSize());
+
+		double cpu = getCpuSeconds();
+		Clock::time_point start = Clock::now();
+		process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+		std::chrono::duration<double> elapsed = Clock::now() - start;
+		cpu = getCpuSeconds() - cpu;
+
+		double gib = static_cast<double>(input.size()) / (1024 * 1024 * 1024);
+		std::cout << std::fixed << std::setprecision(0)
+				<< std::setw(8) << names[variant]
+				<< std::setw(12) << (static_cast<double>(input.size()) / (1024 * 1024) / elapsed.count())
+				<< std::setw(16) << (gib > 0 ? cpu * 1000 / gib : 0.0) << "\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if(argc < 2) {
+		printUsage();
+		return 0;
+	}
+
+	std::string benchmark = argv[1];
+
+	if(benchmark == "spawn" || benchmark == "spawn-reaper") {
+		std::size_t maxThreads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 64;
+		std::chrono::milliseconds duration((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 2000);
+
+		std::unique_ptr<Reaper> reaper;
+		if(benchmark == "spawn-reaper") {
+			reaper.reset(new Reaper);
+		}
+
+		runSpawn(maxThreads, duration);
+	}
+	else if(benchmark == "stream") {
+		std::size_t mib = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 256;
+		std::size_t recordSize = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 64;
+		if(recordSize == 0 || recordSize > 4096) {
+			recordSize = 64;
+		}
+
+		runStream(mib, recordSize);
+	}
+	else if(benchmark == "throughput") {
+		std::size_t mib = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1024;
+
+		runThroughput(mib);
+	}
+	else if(benchmark == "vmsplice") {
+		std::size_t mib = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1024;
+
+		runVmsplice(mib);
+	}
+	else {
+		printUsage();
+	}
+
+	return 0;
+}
@@ -0,0 +1,310 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/ConcurrencyController.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace zsystem {
+
+namespace {
+
+std::size_t getNumberOfCpus() {
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	if(count < 1) {
+		count = std::thread::hardware_concurrency();
+	}
+	return count < 1 ? 1 : static_cast<std::size_t>(count);
+}
+
+/* reads a small file from /proc into buffer, returns false if file is not available */
+bool readProcFile(const char* path, char* buffer, std::size_t size) {
+	int fd;
+	while((fd = open(path, O_RDONLY | O_CLOEXEC)) == -1 && errno == EINTR) { }
+	if(fd == -1) {
+		return false;
+	}
+
+	std::size_t length = 0;
+	while(length + 1 < size) {
+		ssize_t count = read(fd, &buffer[length], size - length - 1);
+		if(count == -1 && errno == EINTR) {
+			continue;
+		}
+		if(count <= 0) {
+			break;
+		}
+		length += count;
+	}
+	close(fd);
+
+	buffer[length] = 0;
+	return length > 0;
+}
+
+/* reads "some total=" of a PSI file in microseconds, returns false if not available */
+bool readPressureTotal(const char* path, std::uint64_t& total) {
+	char buffer[256];
+	if(!readProcFile(path, buffer, sizeof(buffer))) {
+		return false;
+	}
+
+	const char* some = std::strstr(buffer, "some ");
+	if(some == nullptr) {
+		return false;
+	}
+	const char* value = std::strstr(some, "total=");
+	if(value == nullptr) {
+		return false;
+	}
+
+	total = std::strtoull(value + std::strlen("total="), nullptr, 10);
+	return true;
+}
+
+double readLoadAverage() {
+	char buffer[128];
+	if(!readProcFile("/proc/loadavg", buffer, sizeof(buffer))) {
+		return -1.0;
+	}
+
+	return std::strtod(buffer, nullptr);
+}
+
+} /* namespace {anonymous} */
+
+ConcurrencyController::Settings::Settings()
+: maxLimit(4 * getNumberOfCpus()),
+  initialLimit(getNumberOfCpus())
+{ }
+
+ConcurrencyController::Slot::Slot(ConcurrencyController& aConcurrencyController)
+: concurrencyController(&aConcurrencyController)
+{ }
+
+ConcurrencyController::Slot::Slot(Slot&& other)
+: concurrencyController(other.concurrencyController)
+{
+	other.concurrencyController = nullptr;
+}
+
+ConcurrencyController::Slot::~Slot() {
+	release();
+}
+
+ConcurrencyController::Slot& ConcurrencyController::Slot::operator=(Slot&& other) {
+	if(this != &other) {
+		release();
+		concurrencyController = other.concurrencyController;
+		other.concurrencyController = nullptr;
+	}
+
+	return *this;
+}
+
+ConcurrencyController::Slot::operator bool() const noexcept {
+	return concurrencyController != nullptr;
+}
+
+void ConcurrencyController::Slot::release() {
+	if(concurrencyController) {
+		concurrencyController->release();
+		concurrencyController = nullptr;
+	}
+}
+
+ConcurrencyController::ConcurrencyController()
+: ConcurrencyController(Settings())
+{ }
+
+ConcurrencyController::ConcurrencyController(Settings aSettings)
+: settings(std::move(aSettings))
+{
+	metrics.limit = std::max(settings.minLimit, std::min(settings.maxLimit, settings.initialLimit));
+	if(metrics.limit == 0) {
+		metrics.limit = 1;
+	}
+	lastUpdate = std::chrono::steady_clock::now();
+}
+
+ConcurrencyController::Slot ConcurrencyController::acquire() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	updateLocked(std::chrono::steady_clock::now());
+	if(metrics.inFlight >= metrics.limit) {
+		++metrics.waits;
+		while(metrics.inFlight >= metrics.limit) {
+			/* wake up at least every interval to give the controller the chance to increase the limit again */
+			condition.wait_for(lock, settings.interval);
+			updateLocked(std::chrono::steady_clock::now());
+		}
+	}
+
+	++metrics.inFlight;
+	++metrics.acquisitions;
+	metrics.peakInFlight = std::max(metrics.peakInFlight, metrics.inFlight);
+
+	return Slot(*this);
+}
+
+ConcurrencyController::Slot ConcurrencyController::tryAcquire() {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	updateLocked(std::chrono::steady_clock::now());
+	if(metrics.inFlight >= metrics.limit) {
+		return Slot();
+	}
+
+	++metrics.inFlight;
+	++metrics.acquisitions;
+	metrics.peakInFlight = std::max(metrics.peakInFlight, metrics.inFlight);
+
+	return Slot(*this);
+}
+
+void ConcurrencyController::update() {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	/* force a new sample */
+	lastUpdate = std::chrono::steady_clock::now() - settings.interval;
+	updateLocked(std::chrono::steady_clock::now());
+}
+
+ConcurrencyController::Metrics ConcurrencyController::getMetrics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return metrics;
+}
+
+void ConcurrencyController::setDecisionHandler(std::function<void(const Metrics&)> aDecisionHandler) {
+	std::lock_guard<std::mutex> lock(mutex);
+	decisionHandler = std::move(aDecisionHandler);
+}
+
+void ConcurrencyController::release() {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if(metrics.inFlight > 0) {
+		--metrics.inFlight;
+	}
+	condition.notify_one();
+}
+
+void ConcurrencyController::updateLocked(std::chrono::steady_clock::time_point now) {
+	if(now - lastUpdate < settings.interval) {
+		return;
+	}
+	lastUpdate = now;
+
+	bool congested = sample();
+	std::size_t limit = metrics.limit;
+
+	if(congested) {
+		limit = static_cast<std::size_t>(static_cast<double>(limit) * settings.decreaseFactor);
+		limit = std::max(std::max(settings.minLimit, static_cast<std::size_t>(1)), limit);
+	}
+	else if(metrics.inFlight >= metrics.limit) {
+		/* increase only if the current limit is really used */
+		limit = std::min(settings.maxLimit, limit + settings.increaseStep);
+	}
+
+	if(limit < metrics.limit) {
+		metrics.lastDecision = Decision::decrease;
+		++metrics.decreases;
+	}
+	else if(limit > metrics.limit) {
+		metrics.lastDecision = Decision::increase;
+		++metrics.increases;
+		condition.notify_all();
+	}
+	else {
+		metrics.lastDecision = Decision::hold;
+	}
+	metrics.limit = limit;
+
+	if(decisionHandler) {
+		decisionHandler(metrics);
+	}
+}
+
+bool ConcurrencyController::sample() {
+	++metrics.samples;
+
+	if(metrics.source != Source::loadAverage) {
+		std::uint64_t totals[3] = { 0, 0, 0 };
+		if(readPressureTotal("/proc/pressure/cpu", totals[0])) {
+			readPressureTotal("/proc/pressure/memory", totals[1]);
+			readPressureTotal("/proc/pressure/io", totals[2]);
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+			bool hadPressureTotals = hasPressureTotals;
+			std::chrono::duration<double, std::micro> elapsed = now - pressureTime;
+			double pressures[3] = { 0.0, 0.0, 0.0 };
+			for(int i = 0; i < 3; ++i) {
+				if(hadPressureTotals && elapsed.count() > 0.0 && totals[i] >= pressureTotals[i]) {
+					pressures[i] = std::min(100.0, 100.0 * static_cast<double>(totals[i] - pressureTotals[i]) / elapsed.count());
+				}
+				pressureTotals[i] = totals[i];
+			}
+			pressureTime = now;
+			hasPressureTotals = true;
+
+			metrics.source = Source::pressure;
+			metrics.cpuPressure = pressures[0];
+			metrics.memoryPressure = pressures[1];
+			metrics.ioPressure = pressures[2];
+
+			return hadPressureTotals && (metrics.cpuPressure > settings.cpuPressureThreshold
+					|| metrics.memoryPressure > settings.memoryPressureThreshold
+					|| metrics.ioPressure > settings.ioPressureThreshold);
+		}
+	}
+
+	double loadAverage = readLoadAverage();
+	if(loadAverage < 0.0) {
+		metrics.source = Source::none;
+		return false;
+	}
+
+	metrics.source = Source::loadAverage;
+	metrics.loadAverage = loadAverage;
+
+	if(loadAverage / static_cast<double>(getNumberOfCpus()) <= settings.loadAverageThreshold) {
+		decreasedLoadAverage = -1.0;
+		return false;
+	}
+	if(loadAverage == decreasedLoadAverage) {
+		/* not updated by the kernel since the last decrease */
+		return false;
+	}
+	decreasedLoadAverage = loadAverage;
+	return true;
+}
+
+} /* namespace zsystem */
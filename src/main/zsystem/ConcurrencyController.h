@@ -0,0 +1,170 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_CONCURRENCYCONTROLLER_H_
+#define ZSYSTEM_CONCURRENCYCONTROLLER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace zsystem {
+
+/* ConcurrencyController limits the number of children a multi-process runner keeps in flight.
+ *
+ * The limit is adjusted with an AIMD algorithm: Every "interval" the system pressure is sampled from
+ * /proc/pressure/{cpu,memory,io} (PSI). The pressure is the share of the last interval in which some tasks
+ * were stalled, computed from the difference of the "some total=" counter. The first sample has no previous
+ * counter, so it is a hold. If PSI is not available the 1-minute load average of /proc/loadavg divided by the
+ * number of online CPUs is used instead.
+ * - If one of the resources is above its threshold, the limit is multiplied by "decreaseFactor".
+ *   The kernel updates the load average every 5 seconds, so it is applied once per new value only.
+ * - Otherwise, if the current limit is completely used, the limit is increased by "increaseStep".
+ *
+ * A runner calls acquire() before it starts a child and keeps the returned Slot until the child has terminated.
+ */
+class ConcurrencyController {
+public:
+	enum class Source {
+		none,
+		pressure,
+		loadAverage
+	};
+
+	enum class Decision {
+		none,
+		hold,
+		increase,
+		decrease
+	};
+
+	struct Settings {
+		Settings();
+
+		std::size_t minLimit = 1;
+		std::size_t maxLimit;
+		std::size_t initialLimit;
+
+		std::size_t increaseStep = 1;
+		double decreaseFactor = 0.5;
+
+		/* thresholds for PSI "some" in percent of the interval */
+		double cpuPressureThreshold = 25.0;
+		double memoryPressureThreshold = 10.0;
+		double ioPressureThreshold = 25.0;
+
+		/* threshold for load average per CPU, used if PSI is not available */
+		double loadAverageThreshold = 1.0;
+
+		std::chrono::milliseconds interval = std::chrono::milliseconds(1000);
+	};
+
+	struct Metrics {
+		Source source = Source::none;
+		Decision lastDecision = Decision::none;
+
+		std::size_t limit = 0;
+		std::size_t inFlight = 0;
+		std::size_t peakInFlight = 0;
+
+		double cpuPressure = 0.0;
+		double memoryPressure = 0.0;
+		double ioPressure = 0.0;
+		double loadAverage = 0.0;
+
+		std::uint64_t samples = 0;
+		std::uint64_t increases = 0;
+		std::uint64_t decreases = 0;
+		std::uint64_t acquisitions = 0;
+		std::uint64_t waits = 0;
+	};
+
+	class Slot {
+	public:
+		Slot() = default;
+		Slot(const Slot&) = delete;
+		Slot(Slot&& other);
+		~Slot();
+
+		Slot& operator=(const Slot&) = delete;
+		Slot& operator=(Slot&& other);
+
+		explicit operator bool() const noexcept;
+
+		void release();
+
+	private:
+		friend class ConcurrencyController;
+		Slot(ConcurrencyController& concurrencyController);
+
+		ConcurrencyController* concurrencyController = nullptr;
+	};
+	friend class Slot;
+
+	ConcurrencyController();
+	ConcurrencyController(Settings settings);
+	ConcurrencyController(const ConcurrencyController&) = delete;
+
+	ConcurrencyController& operator=(const ConcurrencyController&) = delete;
+
+	/* blocks until the number of children in flight is below the current limit */
+	Slot acquire();
+
+	/* returns an empty slot if the current limit is reached */
+	Slot tryAcquire();
+
+	/* samples the pressure now and adjusts the limit */
+	void update();
+
+	Metrics getMetrics() const;
+
+	/* handler is called after every decision with the metrics of this decision.
+	 * It is called while an internal lock is held, so it must not call back into this object. */
+	void setDecisionHandler(std::function<void(const Metrics&)> decisionHandler);
+
+private:
+	void release();
+	void updateLocked(std::chrono::steady_clock::time_point now);
+	bool sample();
+
+	const Settings settings;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	std::function<void(const Metrics&)> decisionHandler;
+	std::chrono::steady_clock::time_point lastUpdate;
+	Metrics metrics;
+
+	/* previous sample: "some total=" of cpu, memory and io in microseconds, time of the sample */
+	bool hasPressureTotals = false;
+	std::uint64_t pressureTotals[3] = { 0, 0, 0 };
+	std::chrono::steady_clock::time_point pressureTime;
+	/* load average that has caused the last decrease */
+	double decreasedLoadAverage = -1.0;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_CONCURRENCYCONTROLLER_H_ */
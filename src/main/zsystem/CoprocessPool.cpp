@@ -0,0 +1,423 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/CoprocessPool.h>
+#include <zsystem/Signal.h>
+#include <zsystem/process/Environment.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace zsystem {
+
+namespace {
+
+std::size_t getRssBytes(Process::Handle pid) {
+	std::string path = "/proc/" + std::to_string(pid) + "/statm";
+
+	int fd;
+	while((fd = open(path.c_str(), O_RDONLY | O_CLOEXEC)) == -1 && errno == EINTR) { }
+	if(fd == -1) {
+		return 0;
+	}
+
+	char buffer[128];
+	ssize_t count;
+	while((count = read(fd, buffer, sizeof(buffer) - 1)) == -1 && errno == EINTR) { }
+	close(fd);
+	if(count <= 0) {
+		return 0;
+	}
+	buffer[count] = 0;
+
+	/* second field is the resident set size in pages */
+	char* end;
+	std::strtoul(buffer, &end, 10);
+	unsigned long residentPages = std::strtoul(end, nullptr, 10);
+
+	return static_cast<std::size_t>(residentPages) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} /* namespace {anonymous} */
+
+CoprocessPool::CoprocessPool(process::Arguments aArguments, Settings aSettings)
+: arguments(std::move(aArguments)),
+  settings(std::move(aSettings))
+{
+	std::size_t count = (settings.workers == 0) ? 1 : settings.workers;
+	for(std::size_t i = 0; i < count; ++i) {
+		workers.emplace_back(new Worker(arguments));
+	}
+}
+
+CoprocessPool::~CoprocessPool() {
+	for(auto& worker : workers) {
+		if(worker->running) {
+			stopWorker(*worker);
+		}
+	}
+}
+
+void CoprocessPool::setWorkingDir(std::string aWorkingDir) {
+	workingDir = std::move(aWorkingDir);
+}
+
+void CoprocessPool::setEnvironment(std::vector<std::pair<std::string, std::string>> aEnvironment) {
+	environment = std::move(aEnvironment);
+	hasEnvironment = true;
+}
+
+void CoprocessPool::start() {
+	for(auto& worker : workers) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if(worker->busy || worker->running) {
+				continue;
+			}
+			worker->busy = true;
+		}
+
+		try {
+			startWorker(*worker);
+		}
+		catch(...) {
+			release(*worker);
+			throw;
+		}
+		release(*worker);
+	}
+}
+
+std::string CoprocessPool::call(const std::string& request) {
+	if(settings.framing == Framing::lengthPrefix && request.size() > std::numeric_limits<std::uint32_t>::max()) {
+		throw std::runtime_error("CoprocessPool: request of " + std::to_string(request.size()) + " bytes exceeds the length prefix");
+	}
+
+	Worker& worker = acquire();
+
+	std::string response;
+	Result result;
+
+	try {
+		if(!worker.running) {
+			startWorker(worker);
+		}
+		result = exchange(worker, request, response);
+	}
+	catch(...) {
+		if(worker.running) {
+			stopWorker(worker);
+		}
+		release(worker);
+		throw;
+	}
+
+	if(result != Result::success) {
+		stopWorker(worker);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			++metrics.restarts;
+			if(result == Result::timeout) {
+				++metrics.timeouts;
+			}
+		}
+
+		try {
+			startWorker(worker);
+		}
+		catch(...) {
+			/* it will be started again by the next call */
+		}
+		release(worker);
+
+		if(result == Result::timeout) {
+			throw std::runtime_error("CoprocessPool: worker for \"" + arguments.getArgs() + "\" timed out after " + std::to_string(settings.timeout.count()) + "ms");
+		}
+		throw std::runtime_error("CoprocessPool: worker for \"" + arguments.getArgs() + "\" terminated or sent an invalid response");
+	}
+
+	++worker.requests;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++metrics.requests;
+	}
+
+	if(needsRecycle(worker)) {
+		stopWorker(worker);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			++metrics.recycles;
+		}
+
+		try {
+			startWorker(worker);
+		}
+		catch(...) {
+			/* it will be started again by the next call */
+		}
+	}
+
+	release(worker);
+	return response;
+}
+
+CoprocessPool::Metrics CoprocessPool::getMetrics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return metrics;
+}
+
+CoprocessPool::Worker& CoprocessPool::acquire() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while(true) {
+		Worker* idleWorker = nullptr;
+		for(auto& worker : workers) {
+			if(worker->busy) {
+				continue;
+			}
+			/* prefer running workers */
+			if(worker->running) {
+				idleWorker = worker.get();
+				break;
+			}
+			if(idleWorker == nullptr) {
+				idleWorker = worker.get();
+			}
+		}
+
+		if(idleWorker) {
+			idleWorker->busy = true;
+			return *idleWorker;
+		}
+
+		condition.wait(lock);
+	}
+}
+
+void CoprocessPool::release(Worker& worker) {
+	std::lock_guard<std::mutex> lock(mutex);
+	worker.busy = false;
+	condition.notify_one();
+}
+
+void CoprocessPool::startWorker(Worker& worker) {
+	std::pair<process::FileDescriptor, process::FileDescriptor> sockets = process::FileDescriptor::openBidirectional();
+
+	Process::ChildFileDescriptors childFileDescriptors;
+	childFileDescriptors[process::FileDescriptor::stdInHandle] = sockets.second.duplicate();
+	childFileDescriptors[process::FileDescriptor::stdOutHandle] = std::move(sockets.second);
+	childFileDescriptors[process::FileDescriptor::stdErrHandle];
+
+	worker.process.setWorkingDir(workingDir);
+	if(hasEnvironment) {
+		worker.process.setEnvironment(std::unique_ptr<process::Environment>(new process::Environment(environment)));
+	}
+	/* workers live longer than the thread that calls this method */
+	worker.process.setTerminateOnParentDeath(false);
+	worker.process.start(std::move(childFileDescriptors));
+
+	worker.fileDescriptor = std::move(sockets.first);
+	worker.fileDescriptor.setBlocking(false);
+	worker.buffer.clear();
+	worker.searchPos = 0;
+	worker.requests = 0;
+	worker.running = true;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	++metrics.starts;
+}
+
+void CoprocessPool::stopWorker(Worker& worker) {
+	/* worker reads EOF from stdin and should terminate */
+	worker.fileDescriptor.close();
+	worker.running = false;
+
+	if(worker.hung) {
+		/* don't wait for a worker that did not respond */
+		worker.hung = false;
+		Signal::sendSignal(worker.process, Signal::Type::kill);
+		worker.process.wait();
+		return;
+	}
+
+	int rc;
+	for(int i = 0; i < 50; ++i) {
+		if(worker.process.tryWait(rc)) {
+			return;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	Signal::sendSignal(worker.process, Signal::Type::kill);
+	worker.process.wait();
+}
+
+bool CoprocessPool::needsRecycle(const Worker& worker) const {
+	if(settings.maxRequests > 0 && worker.requests >= settings.maxRequests) {
+		return true;
+	}
+
+	if(settings.maxRssBytes > 0 && getRssBytes(worker.process.getHandle()) > settings.maxRssBytes) {
+		return true;
+	}
+
+	return false;
+}
+
+CoprocessPool::Result CoprocessPool::exchange(Worker& worker, const std::string& request, std::string& response) {
+	std::string frame;
+
+	if(settings.framing == Framing::lengthPrefix) {
+		std::uint32_t length = htonl(static_cast<std::uint32_t>(request.size()));
+		frame.reserve(sizeof(length) + request.size());
+		frame.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		frame.append(request);
+	}
+	else {
+		frame.reserve(request.size() + 1);
+		frame.append(request);
+		frame.push_back(settings.delimiter);
+	}
+
+	/* data from the worker before the request would be taken as its response */
+	if(!worker.buffer.empty() || worker.fileDescriptor.getReadableSize() != 0) {
+		return Result::failed;
+	}
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + settings.timeout;
+	std::size_t pos = 0;
+	char buffer[16384];
+
+	while(true) {
+		bool complete = false;
+		if(!parseResponse(worker, response, complete)) {
+			return Result::failed;
+		}
+		if(complete) {
+			/* A response before the whole request has been sent or more than one response would
+			 * shift the responses of the following requests. */
+			return (pos < frame.size() || !worker.buffer.empty()) ? Result::failed : Result::success;
+		}
+
+		int timeoutMs = -1;
+		if(settings.timeout.count() > 0) {
+			std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+			if(remaining.count() <= 0) {
+				worker.hung = true;
+				return Result::timeout;
+			}
+			timeoutMs = static_cast<int>(std::min<std::chrono::milliseconds::rep>(remaining.count() + 1, std::numeric_limits<int>::max()));
+		}
+
+		struct pollfd pollFd;
+		pollFd.fd = worker.fileDescriptor.getHandle();
+		pollFd.events = (pos < frame.size()) ? (POLLIN | POLLOUT) : POLLIN;
+		pollFd.revents = 0;
+
+		int rc = poll(&pollFd, 1, timeoutMs);
+		if(rc == -1) {
+			if(errno == EINTR) {
+				continue;
+			}
+			return Result::failed;
+		}
+		if(rc == 0) {
+			continue;
+		}
+
+		if(pos < frame.size() && (pollFd.revents & POLLOUT)) {
+			/* MSG_NOSIGNAL: we don't want to get SIGPIPE if the worker has terminated */
+			ssize_t count = ::send(worker.fileDescriptor.getHandle(), &frame[pos], frame.size() - pos, MSG_NOSIGNAL);
+			if(count == -1) {
+				if(errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+					return Result::failed;
+				}
+			}
+			else {
+				pos += static_cast<std::size_t>(count);
+			}
+		}
+
+		if(pollFd.revents & (POLLIN | POLLHUP | POLLERR)) {
+			std::size_t count = worker.fileDescriptor.read(buffer, sizeof(buffer));
+			if(count == 0 || count == process::FileDescriptor::npos) {
+				return Result::failed;
+			}
+			if(count != process::FileDescriptor::wouldBlock) {
+				worker.buffer.append(buffer, count);
+			}
+		}
+	}
+}
+
+bool CoprocessPool::parseResponse(Worker& worker, std::string& response, bool& complete) {
+	complete = false;
+
+	if(settings.framing == Framing::lengthPrefix) {
+		std::uint32_t length;
+		if(worker.buffer.size() < sizeof(length)) {
+			return true;
+		}
+		std::memcpy(&length, worker.buffer.data(), sizeof(length));
+		length = ntohl(length);
+
+		if(settings.maxResponseSize > 0 && length > settings.maxResponseSize) {
+			return false;
+		}
+		if(worker.buffer.size() < sizeof(length) + length) {
+			return true;
+		}
+
+		response.assign(worker.buffer, sizeof(length), length);
+		worker.buffer.erase(0, sizeof(length) + length);
+		complete = true;
+		return true;
+	}
+
+	std::size_t pos = worker.buffer.find(settings.delimiter, worker.searchPos);
+	if(pos == std::string::npos) {
+		worker.searchPos = worker.buffer.size();
+		return settings.maxResponseSize == 0 || worker.buffer.size() <= settings.maxResponseSize;
+	}
+
+	response.assign(worker.buffer, 0, pos);
+	worker.buffer.erase(0, pos + 1);
+	worker.searchPos = 0;
+	complete = true;
+	return true;
+}
+
+} /* namespace zsystem */
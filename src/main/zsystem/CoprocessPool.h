@@ -0,0 +1,164 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_COPROCESSPOOL_H_
+#define ZSYSTEM_COPROCESSPOOL_H_
+
+#include <zsystem/Process.h>
+#include <zsystem/process/Arguments.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace zsystem {
+
+/* CoprocessPool keeps N long-living children (workers) and sends requests to them.
+ *
+ * stdin and stdout of every worker are connected to a socketpair (see FileDescriptor::openBidirectional).
+ * A worker reads a request from stdin and writes exactly one response to stdout. Requests and responses are framed
+ * - Framing::lengthPrefix: 4 bytes length in network byte order, followed by the data.
+ * - Framing::delimiter:    data followed by the delimiter. Data must not contain the delimiter.
+ *
+ * call() is thread safe and routes the request to an idle worker. The request is written while the response
+ * is read, so workers that echo data before they have read the whole request don't deadlock.
+ * A worker that terminates, breaks the protocol or exceeds "timeout" is restarted, the request fails
+ * with an exception. Data after the response, e.g. a second response, breaks the protocol as well. Workers are recycled after "maxRequests"
+ * requests or if their resident set size exceeds "maxRssBytes".
+ *
+ * Stderr of the workers is not closed.
+ */
+class CoprocessPool {
+public:
+	enum class Framing {
+		lengthPrefix,
+		delimiter
+	};
+
+	struct Settings {
+		std::size_t workers = 1;
+
+		Framing framing = Framing::lengthPrefix;
+		char delimiter = '\n';
+
+		/* maximum size of a response, 0 = unlimited */
+		std::size_t maxResponseSize = 64 * 1024 * 1024;
+
+		/* recycle worker after this number of requests, 0 = unlimited */
+		std::size_t maxRequests = 0;
+
+		/* recycle worker if its resident set size exceeds this number of bytes, 0 = unlimited */
+		std::size_t maxRssBytes = 0;
+
+		/* maximum time to send a request and receive its response, 0 = unlimited.
+		 * The worker is killed and restarted if it is exceeded. */
+		std::chrono::milliseconds timeout = std::chrono::milliseconds(0);
+	};
+
+	struct Metrics {
+		std::uint64_t requests = 0;
+		std::uint64_t starts = 0;
+		std::uint64_t restarts = 0;
+		std::uint64_t recycles = 0;
+		std::uint64_t timeouts = 0;
+	};
+
+	CoprocessPool(process::Arguments arguments, Settings settings);
+	CoprocessPool(const CoprocessPool&) = delete;
+	~CoprocessPool();
+
+	CoprocessPool& operator=(const CoprocessPool&) = delete;
+
+	/* must be called before the first call */
+	void setWorkingDir(std::string workingDir);
+	void setEnvironment(std::vector<std::pair<std::string, std::string>> environment);
+
+	/* starts all workers that are not running already */
+	void start();
+
+	/* throws std::runtime_error if the worker fails or times out,
+	 * or if a length prefixed request is larger than 4 GiB - 1 */
+	std::string call(const std::string& request);
+
+	Metrics getMetrics() const;
+
+private:
+	struct Worker {
+		Worker(const process::Arguments& arguments)
+		: process(arguments)
+		{ }
+
+		Process process;
+		process::FileDescriptor fileDescriptor;
+		std::string buffer;
+		/* buffer has been searched for the delimiter up to this position */
+		std::size_t searchPos = 0;
+		std::size_t requests = 0;
+		bool running = false;
+		bool busy = false;
+		/* worker has exceeded Settings::timeout and is killed without grace period */
+		bool hung = false;
+	};
+
+	Worker& acquire();
+	void release(Worker& worker);
+
+	void startWorker(Worker& worker);
+	void stopWorker(Worker& worker);
+	bool needsRecycle(const Worker& worker) const;
+
+	enum class Result {
+		success,
+		failed,
+		timeout
+	};
+
+	/* writes the request and reads the response at the same time */
+	Result exchange(Worker& worker, const std::string& request, std::string& response);
+
+	/* takes a complete response from the buffer of the worker.
+	 * return: false if the response breaks the protocol, complete is set if a response has been taken */
+	bool parseResponse(Worker& worker, std::string& response, bool& complete);
+
+	const process::Arguments arguments;
+	const Settings settings;
+
+	std::string workingDir;
+	bool hasEnvironment = false;
+	std::vector<std::pair<std::string, std::string>> environment;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	std::vector<std::unique_ptr<Worker>> workers;
+	Metrics metrics;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_COPROCESSPOOL_H_ */
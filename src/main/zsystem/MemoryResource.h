@@ -0,0 +1,101 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_MEMORYRESOURCE_H_
+#define ZSYSTEM_MEMORYRESOURCE_H_
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#ifdef ZSYSTEM_PMR
+#include <memory_resource>
+#endif
+
+namespace zsystem {
+
+/* Containers and arrays of an execution can be allocated from a std::pmr::memory_resource,
+ * e.g. a std::pmr::monotonic_buffer_resource per request that is released at once.
+ * This is enabled by the CMake option ZSYSTEM_PMR, that requires C++17. Without it
+ * the containers are the plain std containers and a MemoryResource pointer is always nullptr.
+ * nullptr stands for the default: the global heap or std::pmr::get_default_resource(). */
+#ifdef ZSYSTEM_PMR
+using MemoryResource = std::pmr::memory_resource;
+
+template<typename T>
+using Vector = std::pmr::vector<T>;
+
+template<typename Key, typename T>
+using Map = std::pmr::map<Key, T>;
+#else
+class MemoryResource;
+
+template<typename T>
+using Vector = std::vector<T>;
+
+template<typename Key, typename T>
+using Map = std::map<Key, T>;
+#endif
+
+/* creates an empty Vector or Map that allocates from memoryResource */
+template<typename Container>
+Container createContainer(MemoryResource* memoryResource) {
+#ifdef ZSYSTEM_PMR
+	return Container(memoryResource ? memoryResource : std::pmr::get_default_resource());
+#else
+	(void) memoryResource;
+	return Container();
+#endif
+}
+
+/* allocates an array of count trivial objects, like new T[count] */
+template<typename T>
+T* allocateArray(MemoryResource* memoryResource, std::size_t count) {
+#ifdef ZSYSTEM_PMR
+	if(memoryResource) {
+		return static_cast<T*>(memoryResource->allocate(count * sizeof(T), alignof(T)));
+	}
+#else
+	(void) memoryResource;
+#endif
+	return new T[count];
+}
+
+/* releases an array of allocateArray with the same memoryResource and count */
+template<typename T>
+void deallocateArray(MemoryResource* memoryResource, T* data, std::size_t count) {
+#ifdef ZSYSTEM_PMR
+	if(memoryResource) {
+		memoryResource->deallocate(data, count * sizeof(T), alignof(T));
+		return;
+	}
+#else
+	(void) memoryResource;
+	(void) count;
+#endif
+	delete[] data;
+}
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_MEMORYRESOURCE_H_ */
@@ -23,20 +23,28 @@ SOFTWARE.
 #include <zsystem/Process.h>
 #include <zsystem/process/ConsumerFile.h>
 #include <zsystem/process/ProducerFile.h>
-#include <zsystem/process/FeatureProcess.h>
-#include <zsystem/SharedMemory.h>
+#include <zsystem/process/TimerWheel.h>
+#include <zsystem/Reaper.h>
+#include <zsystem/Signal.h>
 #include <zsystem/Logger.h>
 
 #include <unistd.h>
-#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <poll.h>
+#include <signal.h>
 #include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/wait.h>
-#include <sys/time.h>
-#include <sys/times.h>
+#include <sys/timerfd.h>
+#include <time.h>
 
+#include <algorithm>
 #include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <map>
 #include <set>
@@ -48,10 +56,343 @@ namespace zsystem {
 
 namespace {
 Logger logger;
+
+std::uint64_t getMonotonicNs() noexcept {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<std::uint64_t>(now.tv_sec) * 1000000000 + static_cast<std::uint64_t>(now.tv_nsec);
+}
+
+std::uint64_t getMonotonicMs() noexcept {
+	return getMonotonicNs() / 1000000;
+}
+
+/* Blocks SIGPIPE for the calling thread, so writing to a pipe whose reader has terminated fails with EPIPE
+ * instead of terminating the whole process. */
+void blockSigPipe(sigset_t& oldSet, bool& wasPending) noexcept {
+	sigset_t sigPipeSet;
+	sigemptyset(&sigPipeSet);
+	sigaddset(&sigPipeSet, SIGPIPE);
+
+	sigset_t pendingSet;
+	sigpending(&pendingSet);
+	wasPending = (sigismember(&pendingSet, SIGPIPE) == 1);
+
+	pthread_sigmask(SIG_BLOCK, &sigPipeSet, &oldSet);
+}
+
+/* A SIGPIPE raised since blockSigPipe is discarded before unblocking */
+void unblockSigPipe(const sigset_t& oldSet, bool wasPending) noexcept {
+	if(sigismember(&oldSet, SIGPIPE) == 1) {
+		/* has been blocked by the caller already, pending signals belong to the caller */
+		return;
+	}
+
+	if(!wasPending) {
+		sigset_t pendingSet;
+		sigpending(&pendingSet);
+		if(sigismember(&pendingSet, SIGPIPE) == 1) {
+			sigset_t sigPipeSet;
+			sigemptyset(&sigPipeSet);
+			sigaddset(&sigPipeSet, SIGPIPE);
+
+			struct timespec timeout = { 0, 0 };
+			while(sigtimedwait(&sigPipeSet, nullptr, &timeout) == -1 && errno == EINTR) { }
+		}
+	}
+
+	pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
+}
 }
 
 const Process::Handle Process::noHandle = -1;
 
+/* The wakeups of all features of one execution are kept in a timer wheel with 1ms ticks. Only the next tick
+ * of the wheel is armed at the timerfd. So moving a wakeup, e.g. the idle timeout of FeatureTimeout on every
+ * received output, is O(1) and needs no system call. */
+class Process::ParentTimer {
+public:
+	ParentTimer()
+	: timerFileDescriptor(process::FileDescriptor::openTimer()),
+	  startMs(getMonotonicMs())
+	{ }
+
+	process::Feature::Context::Wakeup& addWakeup(std::function<void()> onWakeup) {
+		wakeups.emplace_back(new Wakeup(*this, std::move(onWakeup)));
+		return *wakeups.back();
+	}
+
+	void start(Handle aPid, process::FileDescriptor::Handle aPidHandle) {
+		pid = aPid;
+		pidHandle = aPidHandle;
+	}
+
+	const process::FileDescriptor& getFileDescriptor() const noexcept {
+		return timerFileDescriptor;
+	}
+
+	/* called if the timerfd is readable */
+	void expire() {
+		std::uint64_t expirations;
+		while(read(timerFileDescriptor.getHandle(), &expirations, sizeof(expirations)) == -1 && errno == EINTR) { }
+
+		timerWheel.advance(getTick());
+		arm();
+	}
+
+	/* handles the wakeups until the child has terminated, but does not reap it */
+	void waitExit() {
+		while(true) {
+			struct pollfd pollFds[2];
+			pollFds[0].fd = timerFileDescriptor.getHandle();
+			pollFds[0].events = POLLIN;
+			pollFds[0].revents = 0;
+			pollFds[1].fd = pidHandle;
+			pollFds[1].events = POLLIN;
+			pollFds[1].revents = 0;
+
+			/* without pidfd check the child every 10ms */
+			int rc = (pidHandle != process::FileDescriptor::noHandle) ? poll(pollFds, 2, -1) : poll(pollFds, 1, 10);
+			if(rc == -1) {
+				if(errno == EINTR) {
+					continue;
+				}
+				return;
+			}
+
+			if(pollFds[0].revents & POLLIN) {
+				expire();
+			}
+
+			if(pidHandle != process::FileDescriptor::noHandle) {
+				if(pollFds[1].revents) {
+					return;
+				}
+			}
+			else {
+				siginfo_t info;
+				info.si_pid = 0;
+				if(waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == -1) {
+					if(errno == EINTR) {
+						continue;
+					}
+					/* reaped by the Reaper already */
+					return;
+				}
+				if(info.si_pid == pid) {
+					return;
+				}
+			}
+		}
+	}
+
+private:
+	/* wakes up the parent loop once and calls its handler */
+	class Wakeup : public process::TimerWheel::Timer, public process::Feature::Context::Wakeup {
+	public:
+		Wakeup(ParentTimer& aParentTimer, std::function<void()> aOnWakeup)
+		: parentTimer(aParentTimer),
+		  onWakeup(std::move(aOnWakeup))
+		{ }
+
+		void wakeAfter(std::chrono::milliseconds delay) override {
+			/* one tick more, because the current tick has begun up to 1ms ago */
+			std::uint64_t tick = parentTimer.getTick() + (delay.count() > 0 ? static_cast<std::uint64_t>(delay.count()) + 1 : 1);
+			parentTimer.timerWheel.add(*this, tick);
+			/* A timerfd armed earlier just wakes up the loop, that arms it again. So moving a wakeup to a later
+			 * tick needs no system call. */
+			if(tick < parentTimer.armedTick) {
+				parentTimer.arm();
+			}
+		}
+
+		void cancel() override {
+			parentTimer.timerWheel.cancel(*this);
+			parentTimer.arm();
+		}
+
+	protected:
+		void onExpired() override {
+			if(onWakeup) {
+				onWakeup();
+			}
+		}
+
+	private:
+		ParentTimer& parentTimer;
+		std::function<void()> onWakeup;
+	};
+
+	std::uint64_t getTick() const noexcept {
+		return getMonotonicMs() - startMs;
+	}
+
+	void arm() noexcept {
+		std::uint64_t nextTick = timerWheel.getNextTick();
+		if(nextTick == armedTick) {
+			return;
+		}
+
+		struct itimerspec timerSpec;
+		std::memset(&timerSpec, 0, sizeof(timerSpec));
+		if(nextTick != process::TimerWheel::noTick) {
+			std::uint64_t ms = startMs + nextTick;
+			timerSpec.it_value.tv_sec = static_cast<time_t>(ms / 1000);
+			timerSpec.it_value.tv_nsec = static_cast<long>((ms % 1000) * 1000000);
+		}
+		timerfd_settime(timerFileDescriptor.getHandle(), TFD_TIMER_ABSTIME, &timerSpec, nullptr);
+		armedTick = nextTick;
+	}
+
+	process::FileDescriptor timerFileDescriptor;
+	process::TimerWheel timerWheel;
+	const std::uint64_t startMs;
+	std::uint64_t armedTick = process::TimerWheel::noTick;
+	std::vector<std::unique_ptr<Wakeup>> wakeups;
+	Handle pid = noHandle;
+	process::FileDescriptor::Handle pidHandle = process::FileDescriptor::noHandle;
+};
+
+Process::Execution::Execution(Process& aProcess, ChildFileDescriptors childFileDescriptors, ParameterFeatures& aParameterFeatures)
+: process(aProcess),
+  parameterFeatures(aParameterFeatures)
+{
+	if(process.pid != noHandle) {
+		throw std::runtime_error("Process::execute() failed: child is still running");
+	}
+
+	for(auto& parameterFeature : parameterFeatures) {
+		parameterFeature.get().onBeforeFork(*this);
+	}
+
+	reaper = Reaper::getInstance();
+
+	process.pid = process.childRun(std::move(childFileDescriptors), parameterFeatures, process.environment.get());
+	logger << "PID = " << process.pid << "\n";
+
+	try {
+		/* pidfd must be opened before the Reaper knows the child, otherwise it could be reaped already */
+		if(!parameterFeatures.empty() || reaper) {
+			process.pidFileDescriptor = process::FileDescriptor::openProcess(process.pid);
+		}
+		if(parentTimer) {
+			parentTimer->start(process.pid, process.pidFileDescriptor.getHandle());
+		}
+		for(auto& parameterFeature : parameterFeatures) {
+			parameterFeature.get().onSpawn(process.pid, process.pidFileDescriptor.getHandle());
+		}
+
+		if(reaper) {
+			reaper->add(process.pid, process.pidFileDescriptor.getHandle());
+		}
+	}
+	catch(...) {
+		/* The destructor does not run for an incomplete constructor, so the child is killed and reaped here.
+		 * It is not registered at the Reaper, because add() is the last call that can throw. */
+		Signal::sendSignal(process.pid, process.pidFileDescriptor.getHandle(), false, Signal::Type::kill);
+		int status;
+		while(waitpid(process.pid, &status, 0) == -1 && errno == EINTR) { }
+		process.pid = noHandle;
+		process.pidFileDescriptor.close();
+		throw;
+	}
+
+	/* writing to a pipe whose reader has terminated must not kill this process */
+	blockSigPipe(sigPipeOldSet, sigPipePending);
+}
+
+Process::Execution::~Execution() {
+	if(finished) {
+		return;
+	}
+
+	/* processing the streams has thrown an exception, the child must not be left behind */
+	Signal::sendSignal(process.pid, process.pidFileDescriptor.getHandle(), false, Signal::Type::kill);
+	try {
+		finish();
+	}
+	catch(...) {
+	}
+}
+
+process::Feature::Context::Wakeup& Process::Execution::addWakeup(std::function<void()> onWakeup) {
+	/* executions without wakeups have no timer in the parent loop */
+	if(!parentTimer) {
+		parentTimer.reset(new ParentTimer);
+	}
+	return parentTimer->addWakeup(std::move(onWakeup));
+}
+
+bool Process::Execution::isGroupLeader() const noexcept {
+	return process.group != Group::inherit;
+}
+
+MemoryResource* Process::Execution::getMemoryResource() const noexcept {
+	return process.memoryResource;
+}
+
+process::FileDescriptor::Handle Process::Execution::getTimerHandle() const noexcept {
+	return parentTimer ? parentTimer->getFileDescriptor().getHandle() : process::FileDescriptor::noHandle;
+}
+
+void Process::Execution::timerExpired() {
+	if(parentTimer) {
+		parentTimer->expire();
+	}
+}
+
+void Process::Execution::outputReceived() {
+	for(auto& parameterFeature : parameterFeatures) {
+		parameterFeature.get().onOutput();
+	}
+}
+
+void Process::Execution::iterationDone() {
+	for(auto& parameterFeature : parameterFeatures) {
+		parameterFeature.get().onIteration();
+	}
+}
+
+int Process::Execution::finish() {
+	finished = true;
+	unblockSigPipe(sigPipeOldSet, sigPipePending);
+
+	if(parentTimer) {
+		parentTimer->waitExit();
+	}
+
+	// in case we are reading from the child, we have to return from waitpid
+	// otherwise it might lead to a deadlock in case the child does not terminate
+	// because its output is not being consumed.
+	int status;
+	struct rusage rusage;
+	if(reaper) {
+		Reaper::Result result = reaper->wait(process.pid);
+		status = result.status;
+		rusage = result.rusage;
+	}
+	else {
+		while(wait4(process.pid, &status, 0, &rusage) == -1) {
+			if(errno != EINTR) {
+				status = W_EXITCODE(EXIT_FAILURE, 0);
+				std::memset(&rusage, 0, sizeof(rusage));
+				break;
+			}
+		}
+	}
+
+	for(auto& parameterFeature : parameterFeatures) {
+		parameterFeature.get().onExit(status, rusage);
+	}
+
+	process.pid = noHandle;
+	process.pidFileDescriptor.close();
+
+	int rc = getReturnCode(status);
+	logger << "rc = " << rc << "\n";
+	return rc;
+}
+
 Process::Process(process::Arguments aArguments)
 : arguments(std::move(aArguments))
 { }
@@ -68,46 +409,309 @@ const process::Environment* Process::getEnvironment() const {
 	return environment.get();
 }
 
+void Process::setTerminateOnParentDeath(bool aTerminateOnParentDeath) {
+	terminateOnParentDeath = aTerminateOnParentDeath;
+}
+
+void Process::setGroup(Group aGroup) {
+	group = aGroup;
+}
+
+void Process::setMemoryResource(MemoryResource* aMemoryResource) noexcept {
+	memoryResource = aMemoryResource;
+}
+
+MemoryResource* Process::getMemoryResource() const noexcept {
+	return memoryResource;
+}
+
+void Process::setStreamBufferSize(process::FileDescriptor::Handle handle, std::size_t size) {
+	if(size == 0) {
+		streamBufferSizes.erase(handle);
+	}
+	else {
+		streamBufferSizes[handle] = size;
+	}
+}
+
+Process::Handle Process::start(ChildFileDescriptors childFileDescriptors) {
+	if(pid != noHandle) {
+		throw std::runtime_error("Process::start() failed: child is still running");
+	}
+	if(notifyHandle != process::FileDescriptor::noHandle && childFileDescriptors.count(notifyHandle) > 0) {
+		throw std::runtime_error("Process::start() failed: handle " + std::to_string(notifyHandle) + " is used for notify already");
+	}
+
+	ready = false;
+	status.clear();
+	notifyBuffer.clear();
+	notifyFileDescriptor.close();
+
+	/* the notify variable is set on a copy, so the environment of this object stays as it has been set */
+	std::unique_ptr<process::Environment> notifyEnvironment;
+	if(notifyHandle != process::FileDescriptor::noHandle) {
+		std::pair<process::FileDescriptor, process::FileDescriptor> notifyPipe = process::FileDescriptor::openUnidirectional();
+		notifyFileDescriptor = std::move(notifyPipe.first);
+		notifyFileDescriptor.setBlocking(false);
+		childFileDescriptors[notifyHandle] = std::move(notifyPipe.second);
+
+		notifyEnvironment.reset(new process::Environment(environment ? environment->copy() : process::Environment::copyCurrent(memoryResource)));
+		notifyEnvironment->setValue(notifyVariable, std::to_string(notifyHandle));
+	}
+
+	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
+	Reaper* currentReaper = Reaper::getInstance();
+
+	pid = childRun(std::move(childFileDescriptors), parameterFeatures, notifyEnvironment ? notifyEnvironment.get() : environment.get());
+	logger << "PID = " << pid << "\n";
+
+	/* pidfd must be opened before the Reaper knows the child, otherwise it could be reaped already */
+	pidFileDescriptor = process::FileDescriptor::openProcess(pid);
+
+	reaper = currentReaper;
+	if(reaper) {
+		reaper->add(pid, pidFileDescriptor.getHandle());
+	}
+
+	return pid;
+}
+
+void Process::setNotify(process::FileDescriptor::Handle handle, std::string variable) {
+	notifyHandle = handle;
+	notifyVariable = std::move(variable);
+}
+
+bool Process::waitReady(std::chrono::milliseconds timeout) {
+	std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now() + timeout;
+
+	while(!ready && notifyFileDescriptor) {
+		std::chrono::milliseconds remaining = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - std::chrono::steady_clock::now());
+		if(remaining.count() < 0) {
+			remaining = std::chrono::milliseconds(0);
+		}
+
+		struct pollfd pollFd;
+		pollFd.fd = notifyFileDescriptor.getHandle();
+		pollFd.events = POLLIN;
+		pollFd.revents = 0;
+
+		int rc = poll(&pollFd, 1, static_cast<int>(remaining.count()));
+		if(rc == -1) {
+			if(errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error(std::string("Process::waitReady() failed: ") + std::strerror(errno));
+		}
+		if(rc == 0) {
+			break;
+		}
+
+		updateStatus();
+	}
+
+	return ready;
+}
+
+void Process::updateStatus() {
+	while(notifyFileDescriptor) {
+		char buffer[512];
+		std::size_t count = notifyFileDescriptor.read(buffer, sizeof(buffer));
+		if(count == process::FileDescriptor::wouldBlock) {
+			break;
+		}
+		if(count == 0 || count == process::FileDescriptor::npos) {
+			notifyClose();
+			break;
+		}
+		notifyBuffer.append(buffer, count);
+		notifyParse();
+	}
+}
+
+bool Process::isReady() const noexcept {
+	return ready;
+}
+
+const std::string& Process::getStatus() const noexcept {
+	return status;
+}
+
+void Process::applyStreamBufferSize(process::FileDescriptor::Handle handle, process::FileDescriptor& fileDescriptor, bool isSocket) const {
+	auto iter = streamBufferSizes.find(handle);
+	if(iter == streamBufferSizes.end()) {
+		return;
+	}
+
+	/* it is only a hint, a smaller capacity is not an error */
+	if(isSocket) {
+		if(!fileDescriptor.setSocketBufferSize(iter->second)) {
+			logger << "- setting socket buffer size " << iter->second << " failed\n";
+		}
+	}
+	else {
+		std::size_t pipeSize = fileDescriptor.setPipeSize(iter->second);
+		logger << "- pipe size " << pipeSize << "\n";
+	}
+}
+
+void Process::notifyParse() {
+	std::string::size_type begin = 0;
+	std::string::size_type end;
+
+	while((end = notifyBuffer.find('\n', begin)) != std::string::npos) {
+		std::string line = notifyBuffer.substr(begin, end - begin);
+		begin = end + 1;
+
+		if(line == "READY=1") {
+			ready = true;
+		}
+		else if(line.compare(0, 7, "STATUS=") == 0) {
+			status = line.substr(7);
+		}
+	}
+
+	notifyBuffer.erase(0, begin);
+}
+
+void Process::notifyClose() {
+	/* accept a last assignment without newline */
+	if(!notifyBuffer.empty()) {
+		notifyBuffer += '\n';
+		notifyParse();
+	}
+	notifyFileDescriptor.close();
+}
+
+int Process::wait() {
+	if(pid == noHandle) {
+		throw std::runtime_error("Process::wait() failed: no child started");
+	}
+
+	/* the child blocks on a full notify pipe, so it is read until the child has terminated */
+	while(notifyFileDescriptor) {
+		struct pollfd pollFds[2];
+		pollFds[0].fd = notifyFileDescriptor.getHandle();
+		pollFds[0].events = POLLIN;
+		pollFds[0].revents = 0;
+		pollFds[1].fd = pidFileDescriptor ? pidFileDescriptor.getHandle() : -1;
+		pollFds[1].events = POLLIN;
+		pollFds[1].revents = 0;
+
+		if(poll(pollFds, 2, -1) == -1) {
+			if(errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error(std::string("Process::wait() failed: ") + std::strerror(errno));
+		}
+
+		updateStatus();
+		if(pollFds[1].revents != 0) {
+			break;
+		}
+	}
+
+	int status;
+	if(reaper) {
+		status = reaper->wait(pid).status;
+	}
+	else {
+		while(waitpid(pid, &status, 0) == -1) {
+			if(errno != EINTR) {
+				status = W_EXITCODE(EXIT_FAILURE, 0);
+				break;
+			}
+		}
+	}
+
+	pid = noHandle;
+	pidFileDescriptor.close();
+	reaper = nullptr;
+	if(notifyFileDescriptor) {
+		updateStatus();
+		notifyClose();
+	}
+
+	return getReturnCode(status);
+}
+
+bool Process::tryWait(int& rc) {
+	if(pid == noHandle) {
+		throw std::runtime_error("Process::tryWait() failed: no child started");
+	}
+
+	updateStatus();
+
+	int status;
+	if(reaper) {
+		Reaper::Result result;
+		if(!reaper->tryWait(pid, result)) {
+			return false;
+		}
+		status = result.status;
+	}
+	else {
+		pid_t rcWaitPid;
+		while((rcWaitPid = waitpid(pid, &status, WNOHANG)) == -1 && errno == EINTR) { }
+		if(rcWaitPid == 0) {
+			return false;
+		}
+		if(rcWaitPid == -1) {
+			status = W_EXITCODE(EXIT_FAILURE, 0);
+		}
+	}
+
+	pid = noHandle;
+	pidFileDescriptor.close();
+	reaper = nullptr;
+	if(notifyFileDescriptor) {
+		updateStatus();
+		notifyClose();
+	}
+	rc = getReturnCode(status);
+
+	return true;
+}
+
 int Process::execute() {
-	ParameterFeatures parameterFeatures;
+	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
-	return execute(ParameterStreams(), parameterFeatures);
+	return execute(createContainer<ParameterStreams>(memoryResource), parameterFeatures);
 }
 
 int Process::execute(process::FileDescriptor::Handle handle) {
-	ParameterStreams parameterStream;
-	ParameterFeatures parameterFeatures;
+	ParameterStreams parameterStream = createContainer<ParameterStreams>(memoryResource);
+	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
 	addParameterStream(parameterStream, handle, nullptr, nullptr);
 	return execute(parameterStream, parameterFeatures);
 }
 
 int Process::execute(process::Producer& producer, process::FileDescriptor::Handle handle) {
-	ParameterStreams parameterStream;
-	ParameterFeatures parameterFeatures;
+	ParameterStreams parameterStream = createContainer<ParameterStreams>(memoryResource);
+	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
 	addParameterStream(parameterStream, handle, &producer, nullptr);
 	return execute(parameterStream, parameterFeatures);
 }
 
 int Process::execute(process::Consumer& consumer, process::FileDescriptor::Handle handle) {
-	ParameterStreams parameterStream;
-	ParameterFeatures parameterFeatures;
+	ParameterStreams parameterStream = createContainer<ParameterStreams>(memoryResource);
+	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
 	addParameterStream(parameterStream, handle, nullptr, &consumer);
 	return execute(parameterStream, parameterFeatures);
 }
 
 int Process::execute(process::Feature& feature) {
-	ParameterFeatures parameterFeatures;
+	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
 	parameterFeatures.emplace_back(std::ref(feature));
-	return execute(ParameterStreams(), parameterFeatures);
+	return execute(createContainer<ParameterStreams>(memoryResource), parameterFeatures);
 }
 
 int Process::execute(const ParameterStreams& parameterStreams, ParameterFeatures& parameterFeatures) {
-	ChildFileDescriptors childFileDescriptors;
-	ParentFileDescriptors parentFileDescriptors;
+	ChildFileDescriptors childFileDescriptors = createContainer<ChildFileDescriptors>(memoryResource);
+	ParentFileDescriptors parentFileDescriptors = createContainer<ParentFileDescriptors>(memoryResource);
 
 	for(auto& parameterStream : parameterStreams) {
 		switch(parameterStream.first) {
@@ -132,10 +736,13 @@ int Process::execute(const ParameterStreams& parameterStreams, ParameterFeatures
 
 		if(parameterStream.second.producer && parameterStream.second.consumer) {
 			std::pair<process::FileDescriptor, process::FileDescriptor> tmp = process::FileDescriptor::openBidirectional();
+			applyStreamBufferSize(parameterStream.first, tmp.first, true);
+			applyStreamBufferSize(parameterStream.first, tmp.second, true);
 
 			logger << "- producer & consumer: child-fd=" << tmp.second.getHandle() << " , parent-fd=" << tmp.first.getHandle() << "\n";
 
 			childFileDescriptors[parameterStream.first] = std::move(tmp.second);
+			tmp.first.setBlocking(false);
 			parentFileDescriptors.emplace_back(std::move(tmp.first), parameterStream.second.producer, parameterStream.second.consumer);
 		}
 		else if(parameterStream.second.producer && parameterStream.second.consumer == nullptr) {
@@ -146,10 +753,12 @@ int Process::execute(const ParameterStreams& parameterStreams, ParameterFeatures
 			}
 			else {
 				std::pair<process::FileDescriptor, process::FileDescriptor> tmp = process::FileDescriptor::openUnidirectional();
+				applyStreamBufferSize(parameterStream.first, tmp.first, false);
 
 				logger << "- producer: child-fd=" << tmp.first.getHandle() << " , parent-fd=" << tmp.second.getHandle() << "\n";
 
 				childFileDescriptors[parameterStream.first] = std::move(tmp.first);
+				tmp.second.setBlocking(false);
 				parentFileDescriptors.emplace_back(std::move(tmp.second), parameterStream.second.producer, parameterStream.second.consumer);
 			}
 		}
@@ -161,10 +770,12 @@ int Process::execute(const ParameterStreams& parameterStreams, ParameterFeatures
 			}
 			else {
 				std::pair<process::FileDescriptor, process::FileDescriptor> tmp = process::FileDescriptor::openUnidirectional();
+				applyStreamBufferSize(parameterStream.first, tmp.first, false);
 
 				logger << "- consumer: child-fd=" << tmp.second.getHandle() << " , parent-fd=" << tmp.first.getHandle() << "\n";
 
 				childFileDescriptors[parameterStream.first] = std::move(tmp.second);
+				tmp.first.setBlocking(false);
 				parentFileDescriptors.emplace_back(std::move(tmp.first), parameterStream.second.producer, parameterStream.second.consumer);
 			}
 		}
@@ -174,400 +785,419 @@ int Process::execute(const ParameterStreams& parameterStreams, ParameterFeatures
 		}
 	}
 
-	std::unique_ptr<SharedMemory<process::FeatureTime::TimeData>> timeData;
-	for(auto& parameterFeature : parameterFeatures) {
-		process::FeatureTime* featureTime = dynamic_cast<process::FeatureTime*>(&parameterFeature.get());
-		if(featureTime) {
-			if(!timeData) {
-				timeData.reset(new SharedMemory<process::FeatureTime::TimeData>);
-			}
-			featureTime->setTimeDataPtr(timeData->getData());
-			continue;
-		}
-	}
-
-	pid = childRun(std::move(childFileDescriptors), parameterFeatures, (timeData ? timeData.get()->getData() : nullptr));
-	logger << "PID = " << pid << "\n";
-
-	int rc = parentRun(pid, std::move(parentFileDescriptors), parameterFeatures);
-	logger << "rc = " << rc << "\n";
+	Execution execution(*this, std::move(childFileDescriptors), parameterFeatures);
+	parentRun(execution, std::move(parentFileDescriptors));
 
-	pid = noHandle;
-
-	return rc;
+	return execution.finish();
 }
 
 Process::Handle Process::getHandle() const {
 	return pid;
 }
 
-Process::Handle Process::childRun(ChildFileDescriptors fileDescriptors, ParameterFeatures& parameterFeatures, process::FeatureTime::TimeData* timeData) {
+const process::FileDescriptor& Process::getPidFileDescriptor() const noexcept {
+	return pidFileDescriptor;
+}
+
+Process::Handle Process::childRun(ChildFileDescriptors fileDescriptors, ParameterFeatures& parameterFeatures, const process::Environment* childEnvironment) {
+	/* Everything the child needs is prepared here, because between fork() and exec() the child must
+	 * call async-signal-safe functions only: No allocation, no locks, no stdio, no opendir, ... */
 	char* const* argv = arguments.getArgv();
 
 	char* const* envp = nullptr;
-	if(environment) {
-		envp = environment->getEnvp();
+	if(childEnvironment) {
+		envp = childEnvironment->getEnvp();
 	}
 
 	const char* chdirStr = workingDir.empty() ? nullptr : workingDir.c_str();
 
+	/* targets are sorted ascending, because fileDescriptors is a sorted map */
+	Vector<ChildFileDescriptor> childFileDescriptors = createContainer<Vector<ChildFileDescriptor>>(memoryResource);
+	childFileDescriptors.reserve(fileDescriptors.size());
+	process::FileDescriptor::Handle minTemporaryHandle = 0;
+	for(const auto& fileDescriptor : fileDescriptors) {
+		if(fileDescriptor.first == process::FileDescriptor::noHandle) {
+			continue;
+		}
+
+		ChildFileDescriptor childFileDescriptor;
+		childFileDescriptor.target = fileDescriptor.first;
+		childFileDescriptor.source = fileDescriptor.second ? fileDescriptor.second.getHandle() : process::FileDescriptor::noHandle;
+		childFileDescriptors.push_back(childFileDescriptor);
+
+		minTemporaryHandle = fileDescriptor.first + 1;
+	}
+
+	long openMax = sysconf(_SC_OPEN_MAX);
+	pid_t parentPid = getpid();
+
 	pid_t pid = fork();
 	if(pid == 0) {
 		/* child */
-		pid = getpid();
 
-		/* Terminate child, if parent killed, use once only !!!! */
-		prctl(PR_SET_PDEATHSIG, SIGTERM);
+		if(terminateOnParentDeath) {
+			/* Terminate child, if parent killed, use once only !!!! */
+			prctl(PR_SET_PDEATHSIG, SIGTERM);
+			if(getppid() != parentPid) {
+				/* parent has been terminated already before prctl */
+				_exit(EXIT_FAILURE);
+			}
+		}
+
+		/* SIGCHLD handler of the parent (e.g. installed by Reaper) must not run in the child */
+		signal(SIGCHLD, SIG_DFL);
+
+		if(group == Group::processGroup) {
+			setpgid(0, 0);
+		}
+		else if(group == Group::session && setsid() == -1) {
+			childWriteError("Unable to create session", nullptr);
+			_exit(EXIT_FAILURE);
+		}
 
 		/* ******************* *
 		 * set FileDescriptos  *
 		 * ******************* */
 
-		for(const auto& fileDescriptor : fileDescriptors) {
-			if(fileDescriptor.first == process::FileDescriptor::noHandle) {
+		/* First move all sources above the highest target, so dup2 cannot overwrite a source that is still needed. */
+		for(auto& childFileDescriptor : childFileDescriptors) {
+			if(childFileDescriptor.source == process::FileDescriptor::noHandle) {
 				continue;
 			}
-			if(fileDescriptor.second) {
-				while(close(fileDescriptor.first) == EINTR) { }
-				while(dup2(fileDescriptor.second.getHandle(), fileDescriptor.first) == EINTR) { }
+			while((childFileDescriptor.source = fcntl(childFileDescriptor.source, F_DUPFD, minTemporaryHandle)) == -1 && errno == EINTR) { }
+			if(childFileDescriptor.source == -1) {
+				childWriteError("Cannot duplicate file descriptor", nullptr);
+				_exit(EXIT_FAILURE);
+			}
+		}
+
+		/* dup2 clears FD_CLOEXEC for the target */
+		for(const auto& childFileDescriptor : childFileDescriptors) {
+			if(childFileDescriptor.source == process::FileDescriptor::noHandle) {
+				continue;
 			}
+			while(dup2(childFileDescriptor.source, childFileDescriptor.target) == -1 && errno == EINTR) { }
 		}
 
 
 		/* ********************************* *
 		 * close all opened file descriptors *
 		 * ********************************* */
-		char procDirFd[16];
-		std::sprintf(procDirFd, "/proc/%d/fd/", pid);
-
-		DIR *dir;
-		struct dirent *ent;
+		childCloseFileDescriptors(childFileDescriptors.data(), childFileDescriptors.size(), openMax);
 
-		if((dir = opendir(procDirFd)) == nullptr) {
-			write(STDERR_FILENO, "Cannot open directory: \"", std::strlen("Cannot open directory: \""));
-			write(STDERR_FILENO, procDirFd, std::strlen(procDirFd));
-			write(STDERR_FILENO, "\"\n", std::strlen("\"\n"));
+		if(chdirStr && chdir(chdirStr) == -1) {
+			childWriteError("Unable to change to directory", chdirStr);
 			_exit(EXIT_FAILURE);
 		}
 
-		// get files and directories within directory
-		while((ent = readdir(dir)) != nullptr) {
-			if(ent->d_type == DT_DIR) {
-				continue;
-			}
-
-			// convert file name to int
-			char* end;
-			int fd = strtol(ent->d_name, &end, 32);
-			if(!*end && fileDescriptors.find(fd) == std::end(fileDescriptors)) {
-				// close valid file descriptor
-				while(close(fd) == EINTR) { }
+		for(auto& parameterFeature : parameterFeatures) {
+			if(!parameterFeature.get().onChild()) {
+				_exit(EXIT_FAILURE);
 			}
 		}
-		closedir(dir);
 
-		if(chdirStr && chdir(chdirStr) == -1) {
-			write(STDERR_FILENO, "Unable to change to directory \"", std::strlen("Unable to change to directory \""));
-			write(STDERR_FILENO, chdirStr, std::strlen(chdirStr));
-			write(STDERR_FILENO, "\"\n", std::strlen("\"\n"));
-			_exit(EXIT_FAILURE);
+		if(envp) {
+			execvpe(argv[0], argv, envp);
+		}
+		else {
+			execvp(argv[0], argv);
 		}
 
-		pid_t timerPid = 0;
-		suseconds_t realTimeStartUsec;
-		struct tms startTms;
-
-		if(timeData) {
-			timeval tv;
-			gettimeofday(&tv, nullptr);
-			realTimeStartUsec = tv.tv_sec * 1000000 + tv.tv_usec;
-			times(&startTms);
+		childWriteError("Unable to execute", argv[0]);
+		_exit(EXIT_FAILURE);
+	}
 
-			timerPid = fork();
-			if (timerPid < 0) { /* error */
-				write(STDERR_FILENO, "Inner fork failed.\n", std::strlen("Inner fork failed.\n"));
-				_exit(-2);
-			}
-		}
+	/* fork failed */
+	if(pid < 0) {
+		throw std::runtime_error(std::string("fork() failed: ") + std::strerror(errno));
+	}
 
-		if(timerPid == 0) {
-			/* Check if there has been another fork */
-			if(timeData) {
-				/* Terminate child, if parent killed, use once only !!!! */
-				prctl(PR_SET_PDEATHSIG, SIGTERM);
-			}
+	/* The child calls setpgid as well. Calling it in the parent too ensures the group exists before
+	 * the first group signal is sent. It fails with EACCES if the child has already exec'd, that is fine. */
+	if(group == Group::processGroup) {
+		setpgid(pid, pid);
+	}
 
-			if(envp) {
-				execvpe(argv[0], argv, envp);
-			}
-			else {
-				execvp(argv[0], argv);
-			}
+	return pid;
+}
 
-			write(STDERR_FILENO, "Unable to execute \"", std::strlen("Unable to execute \""));
-			write(STDERR_FILENO, argv[0], std::strlen(argv[0]));
-			write(STDERR_FILENO, "\"\n", std::strlen("\"\n"));
-			_exit(EXIT_FAILURE);
+void Process::childCloseFileDescriptors(const ChildFileDescriptor* childFileDescriptors, std::size_t size, long openMax) {
+#ifdef SYS_close_range
+	/* close the gaps between the sorted targets */
+	unsigned int first = 0;
+	bool success = true;
+	for(std::size_t i = 0; success && i <= size; ++i) {
+		unsigned int last = (i < size) ? static_cast<unsigned int>(childFileDescriptors[i].target) : ~0U;
+		if(last > first) {
+			success = (syscall(SYS_close_range, first, last - 1, 0) == 0);
 		}
+		first = last + 1;
+	}
+	if(success) {
+		return;
+	}
+#endif
 
-		/* we only run to this part if there is an time measurement enabled */
-		long double clktck = static_cast<long double>(sysconf(_SC_CLK_TCK)) / 1000;
-		int rc;
+	/* kernel without close_range: read /proc/self/fd with getdents64, that does not allocate like opendir */
+	int dirFd;
+	while((dirFd = open("/proc/self/fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC)) == -1 && errno == EINTR) { }
+	if(dirFd != -1) {
+		char buffer[1024];
 		while(true) {
-			pid_t rcWaitPid = waitpid(timerPid, &rc, 0);
-
-			timeval tv;
-            gettimeofday(&tv, nullptr);
-
-            double realMs = (tv.tv_sec * 1000000 + tv.tv_usec) - realTimeStartUsec;
-            realMs /= 1000;
-            timeData->realMs = realMs;
-
-    		struct tms endTms;
-            times(&endTms);
-
-            double cuser = endTms.tms_cutime - startTms.tms_cutime;
-            cuser /= clktck;
-            timeData->userMs = cuser;
-
-            double csystem = endTms.tms_cstime - startTms.tms_cstime;
-            csystem /= clktck;
-            timeData->sysMs = csystem;
-
-			if(rcWaitPid == -1) {
-				if (errno == EINTR) {
-					continue;
-				}
-				/* on error */
-				rc = EXIT_FAILURE;
+			long count = syscall(SYS_getdents64, dirFd, buffer, sizeof(buffer));
+			if(count <= 0) {
 				break;
 			}
 
-			if(WIFEXITED(rc)) {
-				rc = WEXITSTATUS(rc);
-				break;
+			for(long offset = 0; offset < count;) {
+				struct linux_dirent64 {
+					ino64_t d_ino;
+					off64_t d_off;
+					unsigned short d_reclen;
+					unsigned char d_type;
+					char d_name[];
+				};
+				const linux_dirent64* entry = reinterpret_cast<const linux_dirent64*>(&buffer[offset]);
+				offset += entry->d_reclen;
+
+				int fd = 0;
+				const char* name = entry->d_name;
+				if(*name < '0' || *name > '9') {
+					continue;
+				}
+				for(; *name >= '0' && *name <= '9'; ++name) {
+					fd = fd * 10 + (*name - '0');
+				}
+				if(fd != dirFd && !childIsTarget(childFileDescriptors, size, fd)) {
+					close(fd);
+				}
 			}
+		}
+		close(dirFd);
+		return;
+	}
 
-			if(WIFSIGNALED(rc)) {
-				// follow the same convention as bash of returning signal values in return codes by adding 128 to them
-				rc = 128 + WTERMSIG(rc);
-				break;
-			}
+	/* no /proc available */
+	for(int fd = 0; fd < openMax; ++fd) {
+		if(!childIsTarget(childFileDescriptors, size, fd)) {
+			close(fd);
 		}
-		_exit(rc);
 	}
+}
 
-	/* fork failed */
-	if(pid < 0) {
-		throw std::runtime_error(std::string("fork() failed: ") + std::strerror(errno));
+bool Process::childIsTarget(const ChildFileDescriptor* childFileDescriptors, std::size_t size, int fd) noexcept {
+	for(std::size_t i = 0; i < size; ++i) {
+		if(childFileDescriptors[i].target == fd) {
+			return true;
+		}
 	}
+	return false;
+}
 
-	return pid;
+void Process::childWriteError(const char* message, const char* value) noexcept {
+	write(STDERR_FILENO, message, std::strlen(message));
+	if(value) {
+		write(STDERR_FILENO, " \"", 2);
+		write(STDERR_FILENO, value, std::strlen(value));
+		write(STDERR_FILENO, "\"", 1);
+	}
+	write(STDERR_FILENO, "\n", 1);
 }
 
 
-int Process::parentRun(Handle pid, ParentFileDescriptors fileDescriptors, ParameterFeatures& parameterFeatures) {
+void Process::parentRun(Execution& execution, ParentFileDescriptors fileDescriptors) {
 	logger << "parentRun:\n";
 	logger << "----------\n\n";
-	int rc = EXIT_FAILURE;
 
-	for(auto& parameterFeature : parameterFeatures) {
-		process::FeatureProcess* featureProcess = dynamic_cast<process::FeatureProcess*>(&parameterFeature.get());
-		if(featureProcess) {
-			featureProcess->setProcessHandle(pid);
-			continue;
-		}
-	}
+	process::FileDescriptor::Handle timerHandle = execution.getTimerHandle();
 
-	while(true) {
-		bool processed = parentProcess(parentPoll(fileDescriptors));
+	ParentPollFileDescriptors pollFileDescriptors = createContainer<ParentPollFileDescriptors>(execution.getMemoryResource());
+	pollFileDescriptors.resize(2 * fileDescriptors.size() + (timerHandle != process::FileDescriptor::noHandle ? 1 : 0));
+	for(std::size_t i = 0; i < fileDescriptors.size(); ++i) {
+		parentPollUpdate(fileDescriptors, pollFileDescriptors, i);
+	}
+	if(timerHandle != process::FileDescriptor::noHandle) {
+		pollFileDescriptors.back().fd = timerHandle;
+		pollFileDescriptors.back().events = POLLIN;
+	}
 
-		if(processed) {
-			continue;
-		}
+	/* all handles are non-blocking, so the loop runs until every stream is finished */
+	while(parentPoll(fileDescriptors, pollFileDescriptors, execution)) {
+		parentProcess(fileDescriptors, pollFileDescriptors, execution);
+		execution.iterationDone();
+	}
+}
 
-		// in case we are reading from the child, we have to return from waitpid
-		// otherwise it might lead to a deadlock in case the child does not terminate
-		// because its output is not being consumed.
-		pid_t rcWaitPid = waitpid(pid, &rc, 0);
+void Process::parentPollUpdate(ParentFileDescriptors& fileDescriptors, ParentPollFileDescriptors& pollFileDescriptors, std::size_t index) noexcept {
+	process::FileDescriptor& fileDescriptor = std::get<0>(fileDescriptors[index]);
+	process::Consumer* consumer = std::get<2>(fileDescriptors[index]);
+	struct pollfd& pollFileDescriptor = pollFileDescriptors[index];
+	struct pollfd& pendingPollFileDescriptor = pollFileDescriptors[fileDescriptors.size() + index];
 
-		if(rcWaitPid == -1) {
-			if (errno == EINTR) {
-				continue;
-			}
-			/* on error */
-			rc = EXIT_FAILURE;
-			break;
-		}
+	process::FileDescriptor::Handle pendingHandle = consumer ? consumer->getPendingHandle() : process::FileDescriptor::noHandle;
 
-		if(WIFEXITED(rc)) {
-			rc = WEXITSTATUS(rc);
-			break;
+	pollFileDescriptor.events = 0;
+	pollFileDescriptor.revents = 0;
+	if(fileDescriptor) {
+		if(std::get<1>(fileDescriptors[index])) {
+			pollFileDescriptor.events |= POLLOUT;
 		}
-
-		if(WIFSIGNALED(rc)) {
-			// follow the same convention as bash of returning signal values in return codes by adding 128 to them
-			rc = 128 + WTERMSIG(rc);
-			break;
+		/* the consumer cannot take data, so its target is polled instead */
+		if(consumer && pendingHandle == process::FileDescriptor::noHandle) {
+			pollFileDescriptor.events |= POLLIN;
 		}
 	}
 
-	for(auto& parameterFeature : parameterFeatures) {
-		process::FeatureProcess* featureProcess = dynamic_cast<process::FeatureProcess*>(&parameterFeature.get());
-		if(featureProcess) {
-			featureProcess->setProcessHandle(noHandle);
-			continue;
-		}
-
-		process::FeatureTime* featureTime = dynamic_cast<process::FeatureTime*>(&parameterFeature.get());
-		if(featureTime) {
-			featureTime->setTimeDataPtr(nullptr);
-			continue;
-		}
-	}
+	/* poll ignores negative handles */
+	pollFileDescriptor.fd = (pollFileDescriptor.events != 0) ? fileDescriptor.getHandle() : -1;
 
-	return rc;
+	pendingPollFileDescriptor.events = POLLOUT;
+	pendingPollFileDescriptor.revents = 0;
+	pendingPollFileDescriptor.fd = (pendingHandle != process::FileDescriptor::noHandle) ? pendingHandle : -1;
 }
 
-Process::PollResults Process::parentPoll(ParentFileDescriptors& fileDescriptors) {
-	PollResults pollResults;
-
-	PollResults polledFileHandles;
-	std::vector<struct pollfd> pollFileHandles;
-
+bool Process::parentPoll(ParentFileDescriptors& fileDescriptors, ParentPollFileDescriptors& pollFileDescriptors, Execution& execution) {
 	logger << "parentPoll:\n";
 	logger << "-----------\n\n";
 
-	for(auto& fileDescriptor : fileDescriptors) {
-		if(!std::get<0>(fileDescriptor)) {
-			logger << "- fd = 'no-handle' (closed handle)\n";
-			continue;
-		}
-
-		struct pollfd tmpPollFd;
-		tmpPollFd.fd = std::get<0>(fileDescriptor).getHandle();
-		tmpPollFd.events = 0;
-		if(std::get<1>(fileDescriptor)) {
-			logger << "- producer available for fd = " << std::get<0>(fileDescriptor).getHandle() << " -> check for POLLOUT\n";
-			tmpPollFd.events |= POLLOUT;
-		}
-		if(std::get<2>(fileDescriptor)) {
-			logger << "- consumer available for fd = " << std::get<0>(fileDescriptor).getHandle() << " -> check for POLLIN\n";
-			tmpPollFd.events |= POLLIN;
-		}
-		if(tmpPollFd.events != 0) {
-			pollFileHandles.push_back(tmpPollFd);
-			polledFileHandles.push_back(std::make_tuple(std::ref(std::get<0>(fileDescriptor)), std::get<1>(fileDescriptor), std::get<2>(fileDescriptor)));
-		}
-		else {
-			logger << "- no producer & no consumer for fd = " << std::get<0>(fileDescriptor).getHandle() << " -> no check\n";
+	bool pollRequired = false;
+	for(std::size_t i = 0; i < 2 * fileDescriptors.size(); ++i) {
+		if(pollFileDescriptors[i].fd >= 0) {
+			logger << "- check fd = " << pollFileDescriptors[i].fd << " for" << ((pollFileDescriptors[i].events & POLLOUT) ? " POLLOUT" : "") << ((pollFileDescriptors[i].events & POLLIN) ? " POLLIN" : "") << "\n";
+			pollRequired = true;
 		}
+		pollFileDescriptors[i].revents = 0;
 	}
 
-	if(pollFileHandles.empty() == false) {
-		logger << "Poll (blocking call) ...\n";
-		while(poll(&pollFileHandles[0], pollFileHandles.size(), -1) == -1 && errno == EINTR) { }
-		logger << "Poll returned\n";
-
-		for(std::size_t i = 0; i < pollFileHandles.size(); ++i) {
-			process::Producer* producer = std::get<1>(polledFileHandles[i]);
-			process::Consumer* consumer = std::get<2>(polledFileHandles[i]);
+	if(!pollRequired) {
+		logger << "- no producer & no consumer -> no check\n";
+		return false;
+	}
 
-			if((pollFileHandles[i].revents & POLLOUT) == 0) {
-				producer = nullptr;
-			}
-			else {
-				logger << "  - writing possible to fd=" << std::get<0>(polledFileHandles[i]).get().getHandle() << "\n";
-			}
+	logger << "Poll (blocking call) ...\n";
+	while(poll(pollFileDescriptors.data(), pollFileDescriptors.size(), -1) == -1 && errno == EINTR) { }
+	logger << "Poll returned\n";
 
-			if((pollFileHandles[i].revents & POLLIN) == 0) {
-				consumer = nullptr;
-			}
-			else {
-				logger << "  - reading possible from fd=" << std::get<0>(polledFileHandles[i]).get().getHandle() << "\n";
-			}
-
-			if(producer || consumer) {
-				pollResults.push_back(std::make_tuple(std::get<0>(polledFileHandles[i]), producer, consumer));
-			}
-		}
+	/* the timer handle follows the streams and the pending handles */
+	if(pollFileDescriptors.size() > 2 * fileDescriptors.size() && (pollFileDescriptors.back().revents & POLLIN)) {
+		execution.timerExpired();
 	}
 
-	return pollResults;
+	return true;
 }
 
-bool Process::parentProcess(PollResults pollResults) {
+void Process::parentProcess(ParentFileDescriptors& fileDescriptors, ParentPollFileDescriptors& pollFileDescriptors, Execution& execution) {
 	logger << "parentProcess:\n";
 	logger << "--------------\n\n";
 
-	bool processed = false;
-	for(auto& pollResult: pollResults) {
-		process::FileDescriptor& fileDescriptor = std::get<0>(pollResult).get();
-		if(!fileDescriptor) {
+	for(std::size_t i = 0; i < fileDescriptors.size(); ++i) {
+		short revents = pollFileDescriptors[i].fd >= 0 ? pollFileDescriptors[i].revents : 0;
+		short pendingRevents = pollFileDescriptors[fileDescriptors.size() + i].fd >= 0 ? pollFileDescriptors[fileDescriptors.size() + i].revents : 0;
+		if(revents == 0 && pendingRevents == 0) {
 			continue;
 		}
 
-		process::Producer* producer = std::get<1>(pollResult);
-		process::Consumer* consumer = std::get<2>(pollResult);
-
-		bool allNpos = true;
+		process::FileDescriptor& fileDescriptor = std::get<0>(fileDescriptors[i]);
+		process::Producer*& producer = std::get<1>(fileDescriptors[i]);
+		process::Consumer*& consumer = std::get<2>(fileDescriptors[i]);
+		bool finished = false;
+		bool consumed = false;
 
 		logger << "Process fd " << fileDescriptor.getHandle() << ".\n";
 
-		/* check if it is possible to send something to the process */
-		if(producer) {
+		/* check if it is possible to send something to the process.
+		 * POLLERR or POLLHUP is set if the child has closed its end, then write fails and the producer is finished. */
+		if(producer && (revents & (POLLOUT | POLLERR | POLLHUP))) {
 			/* send content to the process */
 			logger << "- produce...\n";
 			std::size_t count = producer->produce(fileDescriptor);
 
 			if(count != process::FileDescriptor::npos) {
 				logger << "  - " << count << " bytes produced\n";
-				allNpos = false;
-				processed = (count > 0);
 			}
 			/* check if there is NO MORE content to send to the CGI script */
 			else {
 				logger << "  - produce: no more data available\n";
-				processed = true;
-				/* close write file descriptor */
-				std::get<1>(pollResult) = nullptr; // producer = nullptr;
+				producer = nullptr;
+				finished = true;
 			}
 		}
 
+		/* the target of the consumer can take data again */
+		if(consumer && pendingRevents != 0) {
+			logger << "- consume: flush pending data\n";
+			consumer->flushPending();
+			consumed = true;
+		}
 
-		/* check if it is possible to receive something from the process */
-		if(consumer) {
+		/* check if it is possible to receive something from the process.
+		 * While the consumer cannot take data, the stream is not polled for POLLIN and POLLHUP is left for later. */
+		bool consumerPolled = consumer && (pollFileDescriptors[i].events & POLLIN);
+		bool endOfFile = consumerPolled && isEndOfFile(fileDescriptor, revents);
+		if(consumerPolled && (revents & POLLIN) && !endOfFile) {
 			/* reveive content from the process */
 			logger << "- consume...\n";
+			consumed = true;
 			bool success = consumer->consume(fileDescriptor);
 
 			if(success) {
 				logger << "- consume: successful\n";
-				allNpos = false;
-				processed = true;
+				execution.outputReceived();
 			}
 			/* check if no more data to read desired. drop responseHandler */
 			else {
 				logger << "- consume: no more data desired\n";
-				/* close write file descriptor */
-				std::get<2>(pollResult) = nullptr; // consumer = nullptr;
+				consumer = nullptr;
+				finished = true;
+			}
+		}
+		/* child has closed its end and all data has been read */
+		else if(endOfFile) {
+			consumed = true;
+			if(consumer->flushPending()) {
+				logger << "- consume: end of file\n";
+				consumer = nullptr;
+				finished = true;
+			}
+			else {
+				logger << "- consume: end of file, data pending\n";
 			}
 		}
 
-		if(allNpos) {
-			logger << "- close fd " << fileDescriptor.getHandle() << "\n";
-			fileDescriptor.close();
+		if(finished) {
+			if(producer == nullptr && consumer == nullptr) {
+				logger << "- close fd " << fileDescriptor.getHandle() << "\n";
+				fileDescriptor.close();
+			}
+		}
+		if(finished || consumed) {
+			parentPollUpdate(fileDescriptors, pollFileDescriptors, i);
 		}
 	}
+}
 
-	if(processed) {
-		logger << "- something processed\n";
+bool Process::isEndOfFile(process::FileDescriptor& fileDescriptor, short revents) noexcept {
+	if((revents & (POLLHUP | POLLERR)) == 0) {
+		return false;
 	}
-	else {
-		logger << "- nothing processed\n";
+	if((revents & POLLIN) == 0) {
+		return true;
+	}
+	std::size_t size = fileDescriptor.getReadableSize();
+	return size == 0 || size == process::FileDescriptor::npos;
+}
+
+int Process::getReturnCode(int status) noexcept {
+	if(WIFEXITED(status)) {
+		return WEXITSTATUS(status);
+	}
+
+	if(WIFSIGNALED(status)) {
+		// follow the same convention as bash of returning signal values in return codes by adding 128 to them
+		return 128 + WTERMSIG(status);
 	}
 
-	return processed;
+	return EXIT_FAILURE;
 }
 
 void Process::addParameterStream(ParameterStreams& parameterStreams, process::FileDescriptor::Handle handle, process::Producer* producer, process::Consumer* consumer) {
@@ -23,16 +23,22 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_H_
 #define ZSYSTEM_PROCESS_H_
 
+#include <zsystem/MemoryResource.h>
 #include <zsystem/process/Arguments.h>
 #include <zsystem/process/Environment.h>
 #include <zsystem/process/FileDescriptor.h>
 #include <zsystem/process/Producer.h>
 #include <zsystem/process/Consumer.h>
 #include <zsystem/process/Feature.h>
-#include <zsystem/process/FeatureTime.h>
+#include <zsystem/process/StaticStream.h>
 
+#include <poll.h>
+#include <signal.h>
 #include <unistd.h>
 
+#include <cerrno>
+
+#include <chrono>
 #include <string>
 #include <vector>
 #include <map>
@@ -43,6 +49,13 @@ SOFTWARE.
 
 namespace zsystem {
 
+class Reaper;
+
+/* A Process object must not be used by more than one thread at the same time, but any number of threads
+ * can execute their own Process objects concurrently. The child runs only async-signal-safe code between
+ * fork() and exec(), all file descriptors created by this library are opened with FD_CLOEXEC and the child
+ * closes every file descriptor that has not been passed to it explicitly. So children of concurrent executions
+ * never inherit file descriptors of each other. */
 class Process {
 public:
 	using Handle = pid_t;
@@ -52,9 +65,20 @@ public:
 		process::Producer* producer = nullptr;
 		process::Consumer* consumer = nullptr;
 	};
-	using ParameterStreams = std::map<process::FileDescriptor::Handle, ParameterStream>;
+	using ParameterStreams = Map<process::FileDescriptor::Handle, ParameterStream>;
+
+	using ParameterFeatures = Vector<std::reference_wrapper<process::Feature>>;
 
-	using ParameterFeatures = std::vector<std::reference_wrapper<process::Feature>>;
+	using ChildFileDescriptors = Map<process::FileDescriptor::Handle, process::FileDescriptor>;
+
+	enum class Group {
+		/* child stays in the process group and session of this process */
+		inherit,
+		/* child becomes the leader of a new process group */
+		processGroup,
+		/* child becomes the leader of a new session and process group, e.g. to detach it from the terminal */
+		session
+	};
 
 	Process(process::Arguments arguments);
 
@@ -62,6 +86,60 @@ public:
 	void setEnvironment(std::unique_ptr<process::Environment> environment);
 	const process::Environment* getEnvironment() const;
 
+	/* Child gets SIGTERM if its parent terminates (default: true).
+	 * Linux sends this signal already if the THREAD terminates that has created the child.
+	 * So disable it for children that live longer than the thread that starts them. */
+	void setTerminateOnParentDeath(bool terminateOnParentDeath);
+
+	/* Places the child in its own process group or session (default: Group::inherit).
+	 * Then the child and all its descendants can be signalled at once (see Signal::sendGroupSignal,
+	 * FeatureProcess::stopGroup), and timeouts of FeatureTimeout terminate the whole group.
+	 * Note: A child in its own process group gets SIGTTIN if it reads from the controlling terminal. */
+	void setGroup(Group group);
+
+	/* Capacity of the pipe or socketpair that execute() creates for handle (default: 0, kernel default).
+	 * A pipe is raised by F_SETPIPE_SZ up to FileDescriptor::getPipeMaxSize(), a socketpair gets this
+	 * SO_SNDBUF and SO_RCVBUF. A larger capacity lets producers and consumers move more bytes per syscall. */
+	void setStreamBufferSize(process::FileDescriptor::Handle handle, std::size_t size);
+
+	/* Memory resource for the containers of execute(), e.g. a per-request arena (default: nullptr).
+	 * Has no effect unless ZSYSTEM_PMR is defined, see MemoryResource.h. Use Arguments and Environment
+	 * with the same memory resource to allocate a whole execution from it. */
+	void setMemoryResource(MemoryResource* memoryResource) noexcept;
+	MemoryResource* getMemoryResource() const noexcept;
+
+	/* Starts the child and returns immediately.
+	 * The child gets exactly the given file descriptors, all other file descriptors are closed.
+	 * An empty FileDescriptor keeps the handle of this process open for the child.
+	 * The child must be reaped by wait() or tryWait(). */
+	Handle start(ChildFileDescriptors fileDescriptors);
+
+	/* Readiness notification (sd_notify style) for children started by start().
+	 * The child gets the write end of a pipe at "handle" and the number of this handle in the environment
+	 * variable "variable". The child writes newline terminated assignments like "READY=1" or "STATUS=..." to it.
+	 * start() throws if the file descriptors passed to it contain "handle" as well. */
+	void setNotify(process::FileDescriptor::Handle handle, std::string variable = "ZSYSTEM_NOTIFY_FD");
+
+	/* waits until the child has written "READY=1". Returns false on timeout, if setNotify has not been called
+	 * or if the child has closed the handle without being ready. */
+	bool waitReady(std::chrono::milliseconds timeout);
+	bool isReady() const noexcept;
+
+	/* reads everything the child has written to the notify handle so far without blocking.
+	 * The child blocks if it writes more than the pipe capacity that is not read, so call it regularly
+	 * if the child keeps writing "STATUS=..." or "WATCHDOG=1" after "READY=1". tryWait() and wait() call it, too. */
+	void updateStatus();
+
+	/* returns the last "STATUS=..." the child has written, as of the last updateStatus() */
+	const std::string& getStatus() const noexcept;
+
+	/* blocks until the started child has terminated and returns its return code.
+	 * Keeps reading the notify handle meanwhile. */
+	int wait();
+
+	/* returns true and sets rc if the started child has terminated */
+	bool tryWait(int& rc);
+
 	int execute();
 	int execute(process::FileDescriptor::Handle handle);
 	int execute(process::Producer& producer, process::FileDescriptor::Handle handle);
@@ -71,8 +149,8 @@ public:
 
     template<typename... Args>
 	int execute(process::FileDescriptor::Handle handle, Args&... args) {
-    	ParameterStreams parameterStreams;
-    	ParameterFeatures parameterFeatures;
+    	ParameterStreams parameterStreams = createContainer<ParameterStreams>(memoryResource);
+    	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
     	addParameterStream(parameterStreams, handle, nullptr, nullptr);
     	return execute(parameterStreams, parameterFeatures, args...);
@@ -80,8 +158,8 @@ public:
 
     template<typename... Args>
 	int execute(process::Producer& producer, process::FileDescriptor::Handle handle, Args&... args) {
-    	ParameterStreams parameterStreams;
-    	ParameterFeatures parameterFeatures;
+    	ParameterStreams parameterStreams = createContainer<ParameterStreams>(memoryResource);
+    	ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
     	addParameterStream(parameterStreams, handle, &producer, nullptr);
     	return execute(parameterStreams, parameterFeatures, args...);
@@ -89,8 +167,8 @@ public:
 
 	template<typename... Args>
 	int execute(process::Consumer& consumer, process::FileDescriptor::Handle handle, Args&... args) {
-		ParameterStreams parameterStreams;
-		ParameterFeatures parameterFeatures;
+		ParameterStreams parameterStreams = createContainer<ParameterStreams>(memoryResource);
+		ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
 		addParameterStream(parameterStreams, handle, nullptr, &consumer);
     	return execute(parameterStreams, parameterFeatures, args...);
@@ -98,14 +176,47 @@ public:
 
 	template<typename... Args>
 	int execute(process::Feature& feature, Args&... args) {
-		ParameterFeatures parameterFeatures;
+		ParameterStreams parameterStreams = createContainer<ParameterStreams>(memoryResource);
+		ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
 
 		parameterFeatures.emplace_back(std::ref(feature));
-    	return execute(ParameterStreams(), parameterFeatures, args...);
+    	return execute(parameterStreams, parameterFeatures, args...);
+	}
+
+	/* Static dispatch version of execute for the common case of one producer on stdin and one consumer on stdout.
+	 * stderr is inherited. Lvalues are used by reference and temporaries are moved in, see process::StaticProducer
+	 * and process::StaticConsumer for the accepted types. The loop that processes the streams is instantiated
+	 * for their types, so there is no virtual call and no std::function per chunk. */
+	template<typename ProducerType, typename ConsumerType, typename... Features>
+	int executeStatic(ProducerType&& producer, ConsumerType&& consumer, Features&... features) {
+		ParameterFeatures parameterFeatures = createContainer<ParameterFeatures>(memoryResource);
+		parameterFeatures.assign({ std::ref<process::Feature>(features)... });
+		process::StaticProducer<ProducerType> staticProducer(std::forward<ProducerType>(producer));
+		process::StaticConsumer<ConsumerType> staticConsumer(std::forward<ConsumerType>(consumer));
+
+		std::pair<process::FileDescriptor, process::FileDescriptor> input = process::FileDescriptor::openUnidirectional();
+		std::pair<process::FileDescriptor, process::FileDescriptor> output = process::FileDescriptor::openUnidirectional();
+		input.second.setBlocking(false);
+		output.first.setBlocking(false);
+		applyStreamBufferSize(process::FileDescriptor::stdInHandle, input.first, false);
+		applyStreamBufferSize(process::FileDescriptor::stdOutHandle, output.first, false);
+
+		ChildFileDescriptors childFileDescriptors = createContainer<ChildFileDescriptors>(memoryResource);
+		childFileDescriptors[process::FileDescriptor::stdInHandle] = std::move(input.first);
+		childFileDescriptors[process::FileDescriptor::stdOutHandle] = std::move(output.second);
+		childFileDescriptors[process::FileDescriptor::stdErrHandle];
+
+		Execution execution(*this, std::move(childFileDescriptors), parameterFeatures);
+		staticRun(execution, staticProducer, input.second, staticConsumer, output.first);
+
+		return execution.finish();
 	}
 
 	Handle getHandle() const;
 
+	/* pidfd of the child while it is started or executed with features, empty if not supported */
+	const process::FileDescriptor& getPidFileDescriptor() const noexcept;
+
 private:
 	template<typename... Args>
 	int execute(ParameterStreams& parameterStreams, ParameterFeatures& parameterFeatures, process::FileDescriptor::Handle handle, Args&... args) {
@@ -128,26 +239,156 @@ private:
 	template<typename... Args>
 	int execute(ParameterStreams& parameterStreams, ParameterFeatures& parameterFeatures, process::Feature& feature, Args&... args) {
 		parameterFeatures.emplace_back(std::ref(feature));
-    	return execute(ParameterStreams(), parameterFeatures, args...);
+    	return execute(parameterStreams, parameterFeatures, args...);
 	}
 
-	using ChildFileDescriptors = std::map<process::FileDescriptor::Handle, process::FileDescriptor>;
-	using ParentFileDescriptors = std::vector<std::tuple<process::FileDescriptor, process::Producer*, process::Consumer*>>;
-	using PollResults = std::vector<std::tuple<std::reference_wrapper<process::FileDescriptor>, process::Producer*, process::Consumer*>>;
+	using ParentFileDescriptors = Vector<std::tuple<process::FileDescriptor, process::Producer*, process::Consumer*>>;
+
+	/* Same index as ParentFileDescriptors, followed by the pending handles of the consumers at the same index
+	 * (see Consumer::getPendingHandle) and the timer handle if there is a ParentTimer.
+	 * It is created once per execution and updated only if a stream is finished or its consumer has been called,
+	 * so the parent loop does not allocate anything per iteration. An entry is disabled by a negative handle. */
+	using ParentPollFileDescriptors = Vector<struct pollfd>;
+
+	/* plain copy of ChildFileDescriptors, prepared before fork */
+	struct ChildFileDescriptor {
+		process::FileDescriptor::Handle target;
+		process::FileDescriptor::Handle source;
+	};
+
+	/* wakeups of the features, handled by the parent loop */
+	class ParentTimer;
+
+	/* One child of execute(). The constructor calls the feature hooks and forks, finish() reaps the child.
+	 * Processing the streams is not part of it, so that loop can be instantiated for concrete stream types.
+	 * It is the process::Feature::Context of the features. */
+	class Execution : public process::Feature::Context {
+	public:
+		Execution(Process& process, ChildFileDescriptors childFileDescriptors, ParameterFeatures& parameterFeatures);
+		Execution(const Execution&) = delete;
+		~Execution();
+
+		Execution& operator=(const Execution&) = delete;
+
+		using process::Feature::Context::addWakeup;
+		Wakeup& addWakeup(std::function<void()> onWakeup) override;
+		bool isGroupLeader() const noexcept override;
+
+		/* timerfd to poll for POLLIN, noHandle if there are no wakeups */
+		process::FileDescriptor::Handle getTimerHandle() const noexcept;
+		MemoryResource* getMemoryResource() const noexcept;
+		void timerExpired();
+		void outputReceived();
+		void iterationDone();
+
+		/* waits until the child has terminated, calls onExit of the features and returns the return code */
+		int finish();
+
+	private:
+		Process& process;
+		ParameterFeatures& parameterFeatures;
+		std::unique_ptr<ParentTimer> parentTimer;
+		Reaper* reaper = nullptr;
+		sigset_t sigPipeOldSet;
+		bool sigPipePending = false;
+		bool finished = false;
+	};
+
+	template<typename ProducerType, typename ConsumerType>
+	static void staticRun(Execution& execution, ProducerType& producer, process::FileDescriptor& input, ConsumerType& consumer, process::FileDescriptor& output) {
+		struct pollfd pollFileDescriptors[4];
+		pollFileDescriptors[0].fd = input.getHandle();
+		pollFileDescriptors[0].events = POLLOUT;
+		pollFileDescriptors[1].fd = output.getHandle();
+		pollFileDescriptors[1].events = POLLIN;
+		pollFileDescriptors[2].fd = execution.getTimerHandle();
+		pollFileDescriptors[2].events = POLLIN;
+		/* target of the consumer while it cannot take data, then output is not polled */
+		pollFileDescriptors[3].fd = -1;
+		pollFileDescriptors[3].events = POLLOUT;
+
+		while(input || output) {
+			for(auto& pollFileDescriptor : pollFileDescriptors) {
+				pollFileDescriptor.revents = 0;
+			}
+			while(poll(pollFileDescriptors, 4, -1) == -1 && errno == EINTR) { }
+
+			if(pollFileDescriptors[2].revents & POLLIN) {
+				execution.timerExpired();
+			}
+
+			if(pollFileDescriptors[0].revents & (POLLOUT | POLLERR | POLLHUP)) {
+				if(producer.produce(input) == process::FileDescriptor::npos) {
+					input.close();
+					pollFileDescriptors[0].fd = -1;
+				}
+			}
+
+			if(pollFileDescriptors[3].revents != 0) {
+				consumer.flushPending();
+			}
+
+			bool endOfFile = isEndOfFile(output, pollFileDescriptors[1].revents);
+			if((pollFileDescriptors[1].revents & POLLIN) && !endOfFile) {
+				if(consumer.consume(output)) {
+					execution.outputReceived();
+				}
+				else {
+					output.close();
+				}
+			}
+			else if(endOfFile && consumer.flushPending()) {
+				output.close();
+			}
+
+			process::FileDescriptor::Handle pendingHandle = output ? consumer.getPendingHandle() : process::FileDescriptor::noHandle;
+			pollFileDescriptors[1].fd = (output && pendingHandle == process::FileDescriptor::noHandle) ? output.getHandle() : -1;
+			pollFileDescriptors[3].fd = (pendingHandle != process::FileDescriptor::noHandle) ? pendingHandle : -1;
+
+			execution.iterationDone();
+		}
+	}
+
+	Handle childRun(ChildFileDescriptors fileDescriptors, ParameterFeatures& parameterFeatures, const process::Environment* childEnvironment);
+	static void childCloseFileDescriptors(const ChildFileDescriptor* childFileDescriptors, std::size_t size, long openMax);
+	static bool childIsTarget(const ChildFileDescriptor* childFileDescriptors, std::size_t size, int fd) noexcept;
+	static void childWriteError(const char* message, const char* value) noexcept;
+	static void parentRun(Execution& execution, ParentFileDescriptors fileDescriptors);
+	static void parentPollUpdate(ParentFileDescriptors& fileDescriptors, ParentPollFileDescriptors& pollFileDescriptors, std::size_t index) noexcept;
+	static bool parentPoll(ParentFileDescriptors& fileDescriptors, ParentPollFileDescriptors& pollFileDescriptors, Execution& execution);
+	static void parentProcess(ParentFileDescriptors& fileDescriptors, ParentPollFileDescriptors& pollFileDescriptors, Execution& execution);
+
+	/* true if the child has closed its end and everything has been read. A pipe reports POLLHUP only then,
+	 * but a socket reports POLLIN as well, so the consumer would read 0 bytes forever. */
+	static bool isEndOfFile(process::FileDescriptor& fileDescriptor, short revents) noexcept;
+
+	static int getReturnCode(int status) noexcept;
 
+	void notifyParse();
+	void notifyClose();
 
-	Handle childRun(ChildFileDescriptors fileDescriptors, ParameterFeatures& parameterFeatures, process::FeatureTime::TimeData* timeData);
-	static int parentRun(Handle pid, ParentFileDescriptors fileDescriptors, ParameterFeatures& parameterFeatures);
-	static PollResults parentPoll(ParentFileDescriptors& fileDescriptors);
-	static bool parentProcess(PollResults pollResults);
+	void applyStreamBufferSize(process::FileDescriptor::Handle handle, process::FileDescriptor& fileDescriptor, bool isSocket) const;
 
 	static void addParameterStream(ParameterStreams& parameterStreams, process::FileDescriptor::Handle handle, process::Producer* producer, process::Consumer* consumer);
 
 	process::Arguments arguments;
 	std::unique_ptr<process::Environment> environment;
 	std::string workingDir;
+	bool terminateOnParentDeath = true;
+	Group group = Group::inherit;
+	std::map<process::FileDescriptor::Handle, std::size_t> streamBufferSizes;
+	MemoryResource* memoryResource = nullptr;
+
+	process::FileDescriptor::Handle notifyHandle = process::FileDescriptor::noHandle;
+	std::string notifyVariable;
+	process::FileDescriptor notifyFileDescriptor;
+	std::string notifyBuffer;
+	bool ready = false;
+	std::string status;
 
 	Handle pid = noHandle;
+	process::FileDescriptor pidFileDescriptor;
+	Reaper* reaper = nullptr;
 };
 
 } /* namespace zsystem */
@@ -0,0 +1,325 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/ProcessCache.h>
+#include <zsystem/process/ConsumerFeeder.h>
+#include <zsystem/process/ConsumerString.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace zsystem {
+
+namespace {
+
+const char magic[8] = { 'z', 's', 'y', 's', 'c', 'a', 'c', '1' };
+
+struct Header {
+	char magic[8];
+	std::int64_t rc;
+	std::uint64_t outputSize;
+	std::uint64_t errorSize;
+};
+
+struct Entry {
+	std::string path;
+	std::uint64_t size;
+	struct timespec mtime;
+};
+
+std::atomic<unsigned long> temporaryCounter(0);
+
+bool readAll(int fd, void* data, std::size_t size) {
+	char* ptr = static_cast<char*>(data);
+	while(size > 0) {
+		ssize_t count = ::read(fd, ptr, size);
+		if(count == -1 && errno == EINTR) {
+			continue;
+		}
+		if(count <= 0) {
+			return false;
+		}
+		ptr += count;
+		size -= static_cast<std::size_t>(count);
+	}
+	return true;
+}
+
+bool writeAll(int fd, const void* data, std::size_t size) {
+	const char* ptr = static_cast<const char*>(data);
+	while(size > 0) {
+		ssize_t count = ::write(fd, ptr, size);
+		if(count == -1 && errno == EINTR) {
+			continue;
+		}
+		if(count <= 0) {
+			return false;
+		}
+		ptr += count;
+		size -= static_cast<std::size_t>(count);
+	}
+	return true;
+}
+
+/* passes "size" bytes of the file to the consumer, skips them if consumer is nullptr */
+void replayData(int fd, std::uint64_t size, process::Consumer* consumer) {
+	if(consumer == nullptr) {
+		if(lseek(fd, static_cast<off_t>(size), SEEK_CUR) == -1) {
+			throw std::runtime_error(std::string("ProcessCache::execute() failed: ") + std::strerror(errno));
+		}
+		return;
+	}
+
+	process::ConsumerFeeder consumerFeeder(*consumer);
+	char buffer[65536];
+	while(size > 0) {
+		std::size_t count = std::min<std::uint64_t>(size, sizeof(buffer));
+		if(!readAll(fd, buffer, count)) {
+			throw std::runtime_error("ProcessCache::execute() failed: cannot read cache entry");
+		}
+		size -= count;
+
+		if(!consumerFeeder.feed(buffer, count)) {
+			/* consumer does not want more data */
+			if(lseek(fd, static_cast<off_t>(size), SEEK_CUR) == -1) {
+				throw std::runtime_error(std::string("ProcessCache::execute() failed: ") + std::strerror(errno));
+			}
+			break;
+		}
+	}
+	consumerFeeder.close();
+}
+
+std::uint64_t scanEntries(const std::string& directory, std::vector<Entry>* entries) {
+	std::uint64_t size = 0;
+
+	DIR* dir = opendir(directory.c_str());
+	if(dir == nullptr) {
+		return 0;
+	}
+
+	while(struct dirent* subDirEntry = readdir(dir)) {
+		if(std::strlen(subDirEntry->d_name) != 2 || subDirEntry->d_name[0] == '.') {
+			continue;
+		}
+
+		std::string subDirectory = directory + "/" + subDirEntry->d_name;
+		DIR* subDir = opendir(subDirectory.c_str());
+		if(subDir == nullptr) {
+			continue;
+		}
+
+		while(struct dirent* fileEntry = readdir(subDir)) {
+			if(fileEntry->d_name[0] == '.') {
+				continue;
+			}
+
+			std::string path = subDirectory + "/" + fileEntry->d_name;
+			struct stat fileStat;
+			if(stat(path.c_str(), &fileStat) == -1 || !S_ISREG(fileStat.st_mode)) {
+				continue;
+			}
+
+			size += static_cast<std::uint64_t>(fileStat.st_size);
+			if(entries) {
+				entries->push_back(Entry{ path, static_cast<std::uint64_t>(fileStat.st_size), fileStat.st_mtim });
+			}
+		}
+		closedir(subDir);
+	}
+	closedir(dir);
+
+	return size;
+}
+
+}
+
+ProcessCache::ProcessCache(Settings aSettings)
+: settings(std::move(aSettings))
+{
+	if(settings.directory.empty()) {
+		throw std::runtime_error("ProcessCache::ProcessCache() failed: no directory specified");
+	}
+	if(mkdir(settings.directory.c_str(), 0755) == -1 && errno != EEXIST) {
+		throw std::runtime_error("ProcessCache::ProcessCache() failed to create directory \"" + settings.directory + "\": " + std::strerror(errno));
+	}
+
+	metrics.size = scanEntries(settings.directory, nullptr);
+}
+
+int ProcessCache::execute(Process& process, ProcessKey& key, process::Producer* input, process::Consumer* output, process::Consumer* error) {
+	const std::string& hash = key.getHash();
+
+	int rc;
+	if(replay(getPath(hash), output, error, rc)) {
+		std::lock_guard<std::mutex> lock(mutex);
+		++metrics.hits;
+		return rc;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++metrics.misses;
+	}
+
+	process::ConsumerString outputString;
+	process::ConsumerString errorString;
+
+	Process::ParameterStreams parameterStreams;
+	if(input) {
+		parameterStreams[process::FileDescriptor::stdInHandle].producer = input;
+	}
+	parameterStreams[process::FileDescriptor::stdOutHandle].consumer = &outputString;
+	parameterStreams[process::FileDescriptor::stdErrHandle].consumer = &errorString;
+
+	Process::ParameterFeatures parameterFeatures;
+	rc = process.execute(parameterStreams, parameterFeatures);
+
+	if(rc == 0 || settings.cacheFailures) {
+		store(hash, rc, outputString.getString(), errorString.getString());
+	}
+
+	if(output) {
+		process::ConsumerFeeder consumerFeeder(*output);
+		consumerFeeder.feed(outputString.getString().data(), outputString.getString().size());
+		consumerFeeder.close();
+	}
+	if(error) {
+		process::ConsumerFeeder consumerFeeder(*error);
+		consumerFeeder.feed(errorString.getString().data(), errorString.getString().size());
+		consumerFeeder.close();
+	}
+
+	return rc;
+}
+
+ProcessCache::Metrics ProcessCache::getMetrics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return metrics;
+}
+
+std::string ProcessCache::getPath(const std::string& hash) const {
+	return settings.directory + "/" + hash.substr(0, 2) + "/" + hash;
+}
+
+bool ProcessCache::replay(const std::string& path, process::Consumer* output, process::Consumer* error, int& rc) {
+	process::FileDescriptor fileDescriptor;
+	try {
+		fileDescriptor = process::FileDescriptor::openFile(path, true, false, false);
+	}
+	catch(...) {
+		/* not cached */
+		return false;
+	}
+	int fd = fileDescriptor.getHandle();
+
+	Header header;
+	struct stat fileStat;
+	if(!readAll(fd, &header, sizeof(header))
+			|| std::memcmp(header.magic, magic, sizeof(magic)) != 0
+			|| fstat(fd, &fileStat) == -1
+			|| static_cast<std::uint64_t>(fileStat.st_size) != sizeof(header) + header.outputSize + header.errorSize) {
+		/* corrupt entry */
+		unlink(path.c_str());
+		return false;
+	}
+
+	/* mark entry as recently used */
+	futimens(fd, nullptr);
+
+	replayData(fd, header.outputSize, output);
+	replayData(fd, header.errorSize, error);
+
+	rc = static_cast<int>(header.rc);
+	return true;
+}
+
+void ProcessCache::store(const std::string& hash, int rc, const std::string& output, const std::string& error) {
+	std::string subDirectory = settings.directory + "/" + hash.substr(0, 2);
+	if(mkdir(subDirectory.c_str(), 0755) == -1 && errno != EEXIST) {
+		return;
+	}
+
+	std::string temporaryPath = settings.directory + "/tmp." + std::to_string(getpid()) + "." + std::to_string(++temporaryCounter);
+	int fd;
+	while((fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644)) == -1 && errno == EINTR) { }
+	if(fd == -1) {
+		/* caching is best effort, the result is valid anyway */
+		return;
+	}
+
+	Header header;
+	std::memcpy(header.magic, magic, sizeof(magic));
+	header.rc = rc;
+	header.outputSize = output.size();
+	header.errorSize = error.size();
+
+	bool success = writeAll(fd, &header, sizeof(header))
+			&& writeAll(fd, output.data(), output.size())
+			&& writeAll(fd, error.data(), error.size());
+	success = (::close(fd) == 0) && success;
+
+	if(!success || rename(temporaryPath.c_str(), getPath(hash).c_str()) == -1) {
+		unlink(temporaryPath.c_str());
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	++metrics.stores;
+	metrics.size += sizeof(header) + output.size() + error.size();
+	if(metrics.size > settings.maxSize) {
+		evict();
+	}
+}
+
+void ProcessCache::evict() {
+	std::vector<Entry> entries;
+	metrics.size = scanEntries(settings.directory, &entries);
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+		return a.mtime.tv_sec < b.mtime.tv_sec || (a.mtime.tv_sec == b.mtime.tv_sec && a.mtime.tv_nsec < b.mtime.tv_nsec);
+	});
+
+	std::uint64_t targetSize = settings.maxSize - settings.maxSize / 10;
+	for(const auto& entry : entries) {
+		if(metrics.size <= targetSize) {
+			break;
+		}
+		if(unlink(entry.path.c_str()) == 0) {
+			metrics.size -= entry.size;
+			++metrics.evictions;
+		}
+	}
+}
+
+} /* namespace zsystem */
@@ -0,0 +1,94 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESSCACHE_H_
+#define ZSYSTEM_PROCESSCACHE_H_
+
+#include <zsystem/Process.h>
+#include <zsystem/ProcessKey.h>
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/Producer.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace zsystem {
+
+/* ProcessCache memoizes the results of deterministic executions on disk.
+ *
+ * An entry stores the return code, stdout and stderr of an execution. Its file name is the hash of the
+ * ProcessKey, so any number of ProcessCache objects and processes can share the same directory:
+ *   <directory>/<first 2 hex digits>/<hash>
+ * Entries are written to a temporary file and renamed, so readers never see incomplete entries.
+ *
+ * The modification time of an entry is updated on every hit. If the size of all entries exceeds maxSize,
+ * the least recently used entries are removed until 90% of maxSize is reached.
+ */
+class ProcessCache {
+public:
+	struct Settings {
+		std::string directory;
+		std::uint64_t maxSize = 1024 * 1024 * 1024;
+
+		/* store results with return code != 0 as well */
+		bool cacheFailures = false;
+	};
+
+	struct Metrics {
+		std::uint64_t hits = 0;
+		std::uint64_t misses = 0;
+		std::uint64_t stores = 0;
+		std::uint64_t evictions = 0;
+		std::uint64_t size = 0;
+	};
+
+	ProcessCache(Settings settings);
+	ProcessCache(const ProcessCache&) = delete;
+
+	ProcessCache& operator=(const ProcessCache&) = delete;
+
+	/* Replays the cached result of "key" to "output" (stdout) and "error" (stderr) and returns its return code.
+	 * If there is no cached result, process is executed with stdin from "input" (closed if nullptr) and
+	 * stdout and stderr are captured, stored and passed to the consumers afterwards.
+	 * "key" must contain everything that influences the result, e.g. the content of "input". */
+	int execute(Process& process, ProcessKey& key, process::Producer* input, process::Consumer* output, process::Consumer* error);
+
+	Metrics getMetrics() const;
+
+private:
+	std::string getPath(const std::string& hash) const;
+
+	bool replay(const std::string& path, process::Consumer* output, process::Consumer* error, int& rc);
+	void store(const std::string& hash, int rc, const std::string& output, const std::string& error);
+	void evict();
+
+	const Settings settings;
+
+	mutable std::mutex mutex;
+	Metrics metrics;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESSCACHE_H_ */
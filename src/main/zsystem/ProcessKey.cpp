@@ -0,0 +1,148 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/ProcessKey.h>
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace zsystem {
+
+ProcessKey::ProcessKey(const process::Arguments& arguments) {
+	char** argv = arguments.getArgv();
+	for(std::size_t i = 0; i < arguments.getArgc(); ++i) {
+		addPart('a', argv[i], std::strlen(argv[i]));
+	}
+}
+
+void ProcessKey::addWorkingDir(const std::string& workingDir) {
+	addPart('w', workingDir.data(), workingDir.size());
+}
+
+void ProcessKey::addEnvironment(const std::string& name, const std::string& value) {
+	addPart('e', name.data(), name.size());
+	addPart('v', value.data(), value.size());
+}
+
+void ProcessKey::addInput(const char* data, std::size_t size) {
+	addPart('i', data, size);
+}
+
+void ProcessKey::addInput(const process::ProducerStatic& producer) {
+	addInput(producer.getData(), producer.getSize());
+}
+
+void ProcessKey::addInput(const process::ProducerIovec& producer) {
+	if(!hash.empty()) {
+		throw std::runtime_error("ProcessKey: hash has already been computed");
+	}
+
+	/* same layout as addPart('i', content, size) */
+	char tag = 'i';
+	std::uint64_t size = producer.getSize();
+	sha256.update(&tag, 1);
+	sha256.update(&size, sizeof(size));
+
+	for(const struct iovec& buffer : producer.getBuffers()) {
+		sha256.update(buffer.iov_base, buffer.iov_len);
+	}
+}
+
+void ProcessKey::addInput(process::ProducerFile& producer) {
+	process::FileDescriptor& fileDescriptor = producer.getFileDescriptor();
+	if(!fileDescriptor) {
+		throw std::runtime_error("ProcessKey::addInput() failed: ProducerFile has no file");
+	}
+
+	if(!hash.empty()) {
+		throw std::runtime_error("ProcessKey: hash has already been computed");
+	}
+
+	/* the child reads from the current file position */
+	off_t offset = lseek(fileDescriptor.getHandle(), 0, SEEK_CUR);
+	std::size_t fileSize = producer.getFileSize();
+	if(offset == -1 || fileSize == process::FileDescriptor::npos) {
+		throw std::runtime_error("ProcessKey::addInput() failed: file of ProducerFile is not seekable");
+	}
+
+	/* same layout as addPart('i', content, size), so the key does not depend on the type of producer */
+	char tag = 'i';
+	std::uint64_t size = fileSize - static_cast<std::size_t>(offset);
+	sha256.update(&tag, 1);
+	sha256.update(&size, sizeof(size));
+
+	/* exactly the size of the header is hashed, so the key is the same as for the content in memory */
+	char buffer[65536];
+	for(std::uint64_t remaining = size; remaining > 0;) {
+		std::size_t count = fileDescriptor.pread(buffer, static_cast<std::size_t>(std::min<std::uint64_t>(remaining, sizeof(buffer))), static_cast<std::uint64_t>(offset));
+		if(count == process::FileDescriptor::npos || count == process::FileDescriptor::wouldBlock) {
+			throw std::runtime_error(std::string("ProcessKey::addInput() failed: ") + std::strerror(errno));
+		}
+		if(count == 0) {
+			throw std::runtime_error("ProcessKey::addInput() failed: file of ProducerFile has been truncated");
+		}
+		sha256.update(buffer, count);
+		offset += static_cast<off_t>(count);
+		remaining -= count;
+	}
+}
+
+void ProcessKey::addFile(const std::string& path) {
+	struct stat fileStat;
+	if(stat(path.c_str(), &fileStat) == -1) {
+		throw std::runtime_error("ProcessKey::addFile() failed for \"" + path + "\": " + std::strerror(errno));
+	}
+
+	std::int64_t values[3] = {
+			static_cast<std::int64_t>(fileStat.st_size),
+			static_cast<std::int64_t>(fileStat.st_mtim.tv_sec),
+			static_cast<std::int64_t>(fileStat.st_mtim.tv_nsec)
+	};
+	addPart('f', path.data(), path.size());
+	addPart('s', values, sizeof(values));
+}
+
+const std::string& ProcessKey::getHash() {
+	if(hash.empty()) {
+		hash = sha256.getHex();
+	}
+	return hash;
+}
+
+void ProcessKey::addPart(char tag, const void* data, std::size_t size) {
+	if(!hash.empty()) {
+		throw std::runtime_error("ProcessKey: hash has already been computed");
+	}
+
+	std::uint64_t length = size;
+	sha256.update(&tag, 1);
+	sha256.update(&length, sizeof(length));
+	sha256.update(data, size);
+}
+
+} /* namespace zsystem */
@@ -0,0 +1,77 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESSKEY_H_
+#define ZSYSTEM_PROCESSKEY_H_
+
+#include <zsystem/Sha256.h>
+#include <zsystem/process/Arguments.h>
+#include <zsystem/process/ProducerFile.h>
+#include <zsystem/process/ProducerIovec.h>
+#include <zsystem/process/ProducerStatic.h>
+
+#include <cstdint>
+#include <string>
+
+namespace zsystem {
+
+/* ProcessKey identifies the result of a deterministic execution by a SHA-256 hash over everything that
+ * influences it. The caller adds the parts that are relevant for the executed program:
+ * - the working directory
+ * - the environment variables the program depends on (not the whole environment)
+ * - the content of stdin
+ * - modification time and size of input files the program reads by name
+ *
+ * Every part is added with a tag and its length, so different combinations never produce the same input. */
+class ProcessKey {
+public:
+	ProcessKey(const process::Arguments& arguments);
+
+	void addWorkingDir(const std::string& workingDir);
+	void addEnvironment(const std::string& name, const std::string& value);
+
+	void addInput(const char* data, std::size_t size);
+	void addInput(const process::ProducerStatic& producer);
+
+	/* same key as addInput() with all buffers concatenated */
+	void addInput(const process::ProducerIovec& producer);
+
+	/* reads the content of the file without changing its file position */
+	void addInput(process::ProducerFile& producer);
+
+	/* adds name, modification time and size of a file, but not its content */
+	void addFile(const std::string& path);
+
+	/* returns the hash as 64 hex digits. Parts cannot be added anymore afterwards. */
+	const std::string& getHash();
+
+private:
+	void addPart(char tag, const void* data, std::size_t size);
+
+	Sha256 sha256;
+	std::string hash;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESSKEY_H_ */
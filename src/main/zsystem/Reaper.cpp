@@ -0,0 +1,302 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/Reaper.h>
+#include <zsystem/Signal.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zsystem {
+
+namespace {
+std::atomic<Reaper*> instance(nullptr);
+}
+
+Reaper::Reaper() {
+	Reaper* expected = nullptr;
+	if(!instance.compare_exchange_strong(expected, this)) {
+		throw std::runtime_error("There is already an instance of Reaper");
+	}
+
+	int pipeFd[2];
+	if(pipe2(pipeFd, O_CLOEXEC | O_NONBLOCK) == -1) {
+		instance.store(nullptr);
+		throw std::runtime_error(std::string("Reaper: pipe2() failed: ") + std::strerror(errno));
+	}
+	pipeReadFd = pipeFd[0];
+	pipeWriteFd = pipeFd[1];
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	struct epoll_event event;
+	std::memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	/* data 0 is the pipe, every other value is the pid of a pidfd */
+	event.data.u64 = 0;
+	if(epollFd == -1 || epoll_ctl(epollFd, EPOLL_CTL_ADD, pipeReadFd, &event) == -1) {
+		int savedErrno = errno;
+		if(epollFd != -1) {
+			close(epollFd);
+		}
+		close(pipeReadFd);
+		close(pipeWriteFd);
+		instance.store(nullptr);
+		throw std::runtime_error(std::string("Reaper: epoll failed: ") + std::strerror(savedErrno));
+	}
+
+	int fd = pipeWriteFd;
+	signalHandlerHandle = SignalHandler::install(Signal::Type::child, [fd]() {
+		int savedErrno = errno;
+		while(::write(fd, "c", 1) == -1 && errno == EINTR) { }
+		errno = savedErrno;
+	});
+
+	thread = std::thread(&Reaper::run, this);
+}
+
+Reaper::~Reaper() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+	}
+	notify();
+	thread.join();
+
+	/* remove signal handler before the pipe is closed */
+	signalHandlerHandle = SignalHandler::Handle();
+
+	close(epollFd);
+	close(pipeReadFd);
+	close(pipeWriteFd);
+
+	instance.store(nullptr);
+}
+
+Reaper* Reaper::getInstance() noexcept {
+	return instance.load();
+}
+
+void Reaper::add(Process::Handle pid, process::FileDescriptor::Handle pidHandle, std::function<void(const Result&)> handler) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		std::unique_ptr<Entry>& entry = entries[pid];
+		if(entry) {
+			throw std::runtime_error("Reaper: process " + std::to_string(pid) + " is registered already");
+		}
+		entry.reset(new Entry);
+		entry->handler = std::move(handler);
+
+		if(pidHandle != process::FileDescriptor::noHandle) {
+			struct epoll_event event;
+			std::memset(&event, 0, sizeof(event));
+			event.events = EPOLLIN;
+			event.data.u64 = static_cast<std::uint64_t>(pid);
+			/* level triggered, so a child that has terminated already is reported immediately */
+			if(epoll_ctl(epollFd, EPOLL_CTL_ADD, pidHandle, &event) == 0) {
+				entry->pidHandle = pidHandle;
+				return;
+			}
+		}
+		pidsWithoutPidfd.insert(pid);
+	}
+
+	/* child might have terminated before it has been registered */
+	notify();
+}
+
+Reaper::Result Reaper::wait(Process::Handle pid) {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	auto iter = entries.find(pid);
+	if(iter == std::end(entries)) {
+		throw std::runtime_error("Reaper: process " + std::to_string(pid) + " is not registered");
+	}
+
+	Entry& entry = *iter->second;
+	while(!entry.terminated) {
+		entry.condition.wait(lock);
+	}
+
+	Result result = entry.result;
+	entries.erase(iter);
+
+	return result;
+}
+
+bool Reaper::tryWait(Process::Handle pid, Result& result) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = entries.find(pid);
+	if(iter == std::end(entries)) {
+		throw std::runtime_error("Reaper: process " + std::to_string(pid) + " is not registered");
+	}
+
+	if(!iter->second->terminated) {
+		return false;
+	}
+
+	result = iter->second->result;
+	entries.erase(iter);
+
+	return true;
+}
+
+void Reaper::run() {
+	struct epoll_event events[64];
+
+	while(true) {
+		/* timeout is just a safety net. Usually we are woken up by a pidfd, by SIGCHLD or by add(). */
+		int count = epoll_wait(epollFd, events, 64, 1000);
+
+		char buffer[256];
+		while(::read(pipeReadFd, buffer, sizeof(buffer)) > 0) { }
+
+		std::unique_lock<std::mutex> lock(mutex);
+		if(!running) {
+			break;
+		}
+
+		for(int i = 0; i < count; ++i) {
+			if(events[i].data.u64 != 0) {
+				reap(static_cast<Process::Handle>(events[i].data.u64), lock);
+			}
+		}
+
+		if(!pidsWithoutPidfd.empty()) {
+			lock.unlock();
+			reap();
+		}
+	}
+}
+
+void Reaper::reap() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while(true) {
+		siginfo_t info;
+		std::memset(&info, 0, sizeof(info));
+
+		/* peek on next terminated child without reaping it */
+		if(waitid(P_ALL, 0, &info, WEXITED | WNOHANG | WNOWAIT) == -1) {
+			if(errno == EINTR) {
+				continue;
+			}
+			/* ECHILD: there are no children at all */
+			break;
+		}
+
+		if(info.si_pid == 0) {
+			/* no terminated child */
+			break;
+		}
+
+		auto iter = entries.find(info.si_pid);
+		if(iter == std::end(entries) || iter->second->terminated) {
+			/* The next terminated child does not belong to us, so it stays a zombie until its owner reaps it.
+			 * As long as it exists waitid returns always this child. So we have to check our registered
+			 * children without pidfd one by one. The others are reaped by run() if their pidfd becomes readable. */
+			std::vector<Process::Handle> pids(pidsWithoutPidfd.begin(), pidsWithoutPidfd.end());
+			for(auto pid : pids) {
+				reap(pid, lock);
+			}
+			break;
+		}
+
+		if(!reap(info.si_pid, lock)) {
+			break;
+		}
+	}
+}
+
+bool Reaper::reap(Process::Handle pid, std::unique_lock<std::mutex>& lock) {
+	int status = 0;
+	struct rusage rusage;
+	pid_t rc;
+
+	auto iter = entries.find(pid);
+	if(iter == std::end(entries) || iter->second->terminated) {
+		return false;
+	}
+
+	while((rc = wait4(pid, &status, WNOHANG, &rusage)) == -1 && errno == EINTR) { }
+	if(rc == 0) {
+		return false;
+	}
+
+	Entry& entry = *iter->second;
+	if(entry.pidHandle != process::FileDescriptor::noHandle) {
+		/* remove the pidfd before the caller gets the result, because afterwards the caller may close it */
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, entry.pidHandle, nullptr);
+		entry.pidHandle = process::FileDescriptor::noHandle;
+	}
+	else {
+		pidsWithoutPidfd.erase(pid);
+	}
+
+	if(rc == -1) {
+		/* on error, e.g. somebody else has reaped the child already */
+		status = W_EXITCODE(EXIT_FAILURE, 0);
+		std::memset(&rusage, 0, sizeof(rusage));
+	}
+
+	entry.terminated = true;
+	entry.result.pid = pid;
+	entry.result.status = status;
+	entry.result.rusage = rusage;
+
+	if(entry.handler) {
+		std::function<void(const Result&)> handler = std::move(entry.handler);
+		Result result = entry.result;
+		entries.erase(iter);
+
+		lock.unlock();
+		handler(result);
+		lock.lock();
+	}
+	else {
+		entry.condition.notify_all();
+	}
+
+	return true;
+}
+
+void Reaper::notify() {
+	int savedErrno = errno;
+	while(::write(pipeWriteFd, "a", 1) == -1 && errno == EINTR) { }
+	errno = savedErrno;
+}
+
+} /* namespace zsystem */
@@ -0,0 +1,122 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_REAPER_H_
+#define ZSYSTEM_REAPER_H_
+
+#include <zsystem/Process.h>
+#include <zsystem/SignalHandler.h>
+
+#include <sys/resource.h>
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace zsystem {
+
+/* Reaper is a central component that reaps terminated children of this process.
+ *
+ * As long as an instance of Reaper exists, Process does not block its own thread in waitpid anymore.
+ * Instead it registers the pid and the pidfd of its child and the reaper thread dispatches the exit status and
+ * resource usage to it. The pidfds are kept in an epoll set. A pidfd becomes readable when its child has
+ * terminated, then the child is reaped with wait4. So the cost of reaping is proportional to the number of
+ * terminated children, even if a terminated child of somebody else is pending.
+ * Children registered without pidfd (Linux < 5.3) are found on SIGCHLD by peeking on terminated children
+ * with waitid(P_ALL, ..., WNOHANG | WNOWAIT). While a terminated child of somebody else is pending, all of
+ * them have to be tried.
+ *
+ * Children that are not registered are not reaped by the Reaper, so they can still be waited for by their owner.
+ *
+ * There can be only one instance of Reaper at the same time. It should be created at the beginning of
+ * your process (see SignalHandler) and destroyed when there are no more registered children.
+ */
+class Reaper {
+public:
+	struct Result {
+		Process::Handle pid = Process::noHandle;
+
+		/* status as returned by waitpid */
+		int status = 0;
+		struct rusage rusage;
+	};
+
+	Reaper();
+	Reaper(const Reaper&) = delete;
+	~Reaper();
+
+	Reaper& operator=(const Reaper&) = delete;
+
+	/* returns the current instance or nullptr if there is no Reaper */
+	static Reaper* getInstance() noexcept;
+
+	/* Registers a child. This must be done by the thread that has forked the child.
+	 * pidHandle is a pidfd of the child or FileDescriptor::noHandle. It stays owned by the caller, but must be kept
+	 * open until the result has been passed on.
+	 * If a handler is given, it is called by the reaper thread as soon as the child has terminated.
+	 * Otherwise the result is kept until wait or tryWait is called.
+	 * Throws if pid is registered already and its result has not been passed on. */
+	void add(Process::Handle pid, process::FileDescriptor::Handle pidHandle, std::function<void(const Result&)> handler = nullptr);
+
+	/* blocks until the registered child has terminated */
+	Result wait(Process::Handle pid);
+
+	/* returns true and sets result if the registered child has terminated */
+	bool tryWait(Process::Handle pid, Result& result);
+
+private:
+	struct Entry {
+		process::FileDescriptor::Handle pidHandle = process::FileDescriptor::noHandle;
+		bool terminated = false;
+		Result result;
+		std::function<void(const Result&)> handler;
+		std::condition_variable condition;
+	};
+
+	void run();
+	void reap();
+	bool reap(Process::Handle pid, std::unique_lock<std::mutex>& lock);
+	void notify();
+
+	int pipeReadFd = -1;
+	int pipeWriteFd = -1;
+	int epollFd = -1;
+	bool running = true;
+
+	std::mutex mutex;
+	std::map<Process::Handle, std::unique_ptr<Entry>> entries;
+
+	/* registered children without pidfd, they are reaped by peeking with waitid */
+	std::set<Process::Handle> pidsWithoutPidfd;
+
+	SignalHandler::Handle signalHandlerHandle;
+	std::thread thread;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_REAPER_H_ */
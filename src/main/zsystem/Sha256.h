@@ -0,0 +1,54 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_SHA256_H_
+#define ZSYSTEM_SHA256_H_
+
+#include <cstdint>
+#include <string>
+
+namespace zsystem {
+
+/* Incremental SHA-256 (FIPS 180-4), used to build keys of executions */
+class Sha256 {
+public:
+	Sha256();
+
+	void update(const void* data, std::size_t size);
+	void update(const std::string& data);
+
+	/* finishes the hash and returns it as 64 lower case hex digits. The object must not be updated afterwards. */
+	std::string getHex();
+
+private:
+	void transform(const unsigned char* block) noexcept;
+
+	std::uint32_t state[8];
+	unsigned char buffer[64];
+	std::size_t bufferSize = 0;
+	std::uint64_t totalSize = 0;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_SHA256_H_ */
@@ -0,0 +1,377 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/ShardedProcess.h>
+#include <zsystem/Process.h>
+#include <zsystem/process/ConsumerFeeder.h>
+#include <zsystem/process/ConsumerString.h>
+#include <zsystem/process/Environment.h>
+#include <zsystem/process/Feature.h>
+#include <zsystem/process/ProducerDynamic.h>
+#include <zsystem/Signal.h>
+
+#include <poll.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace zsystem {
+
+namespace {
+
+class ChildFeature;
+
+struct Shards {
+	std::mutex mutex;
+	std::condition_variable condition;
+
+	/* chunks read by the reader, not yet taken by a worker */
+	std::deque<std::string> chunks;
+	std::size_t readChunks = 0;
+	bool inputEnd = false;
+	std::size_t nextChunk = 0;
+
+	std::map<std::size_t, std::pair<int, std::string>> results;
+	std::size_t nextResult = 0;
+	std::size_t finishedWorkers = 0;
+
+	/* read by the reader without lock while it waits for input */
+	std::atomic<bool> aborted{false};
+	std::exception_ptr exception;
+
+	/* children that are running, they are killed if the execution is aborted */
+	std::set<ChildFeature*> children;
+};
+
+/* Makes the child of a worker reachable for abort(). pid and pidHandle are guarded by the mutex of Shards,
+ * so abort() never signals a child that has been reaped already. */
+class ChildFeature : public process::Feature {
+public:
+	ChildFeature(Shards& aShards)
+	: shards(aShards)
+	{ }
+
+	void onSpawn(pid_t aPid, process::FileDescriptor::Handle aPidHandle) override {
+		std::lock_guard<std::mutex> lock(shards.mutex);
+		pid = aPid;
+		pidHandle = aPidHandle;
+		shards.children.insert(this);
+		if(shards.aborted) {
+			kill();
+		}
+	}
+
+	void onExit(int, const struct rusage&) override {
+		std::lock_guard<std::mutex> lock(shards.mutex);
+		shards.children.erase(this);
+		pid = Process::noHandle;
+		pidHandle = process::FileDescriptor::noHandle;
+	}
+
+	/* must be called with lock */
+	void kill() noexcept {
+		Signal::sendSignal(pid, pidHandle, false, Signal::Type::kill);
+	}
+
+private:
+	Shards& shards;
+	Process::Handle pid = Process::noHandle;
+	process::FileDescriptor::Handle pidHandle = process::FileDescriptor::noHandle;
+};
+
+/* must be called with lock. Children that are running are killed, so their workers return promptly. */
+void abort(Shards& shards) {
+	shards.aborted = true;
+	for(auto child : shards.children) {
+		child->kill();
+	}
+	shards.condition.notify_all();
+}
+
+/* waits until input is readable. Returns false if the execution has been aborted meanwhile. */
+bool waitReadable(Shards& shards, process::FileDescriptor& input) {
+	while(!shards.aborted) {
+		struct pollfd pollFd;
+		pollFd.fd = input.getHandle();
+		pollFd.events = POLLIN;
+		pollFd.revents = 0;
+		/* wake up from time to time to check if the execution has been aborted */
+		if(poll(&pollFd, 1, 100) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* called by the reader without lock. Returns false if there is no more input. */
+bool readChunk(Shards& shards, process::FileDescriptor& input, std::string& remainder, bool& inputEnd, std::string& chunk, char delimiter, std::size_t chunkSize) {
+	chunk = std::move(remainder);
+	remainder.clear();
+
+	/* there is no delimiter in chunk before this position */
+	std::size_t searchPos = 0;
+
+	while(true) {
+		while(!inputEnd && chunk.size() < searchPos + chunkSize) {
+			if(!waitReadable(shards, input)) {
+				return false;
+			}
+
+			std::size_t size = chunk.size();
+			chunk.resize(searchPos + chunkSize);
+
+			std::size_t count = input.read(&chunk[size], chunk.size() - size);
+			if(count == process::FileDescriptor::wouldBlock) {
+				count = 0;
+			}
+			else if(count == 0 || count == process::FileDescriptor::npos) {
+				count = 0;
+				inputEnd = true;
+			}
+			chunk.resize(size + count);
+		}
+
+		if(inputEnd) {
+			return !chunk.empty();
+		}
+
+		for(std::size_t pos = chunk.size(); pos > searchPos; --pos) {
+			if(chunk[pos - 1] == delimiter) {
+				remainder.assign(chunk, pos, std::string::npos);
+				chunk.resize(pos);
+				return true;
+			}
+		}
+
+		/* record is longer than chunkSize, so we need more input */
+		searchPos = chunk.size();
+	}
+}
+
+} /* namespace {anonymous} */
+
+ShardedProcess::ShardedProcess(process::Arguments aArguments, std::size_t aWorkers)
+: arguments(std::move(aArguments)),
+  workers(aWorkers == 0 ? 1 : aWorkers)
+{ }
+
+void ShardedProcess::setWorkingDir(std::string aWorkingDir) {
+	workingDir = std::move(aWorkingDir);
+}
+
+void ShardedProcess::setEnvironment(std::vector<std::pair<std::string, std::string>> aEnvironment) {
+	environment = std::move(aEnvironment);
+	hasEnvironment = true;
+}
+
+void ShardedProcess::setDelimiter(char aDelimiter) {
+	delimiter = aDelimiter;
+}
+
+void ShardedProcess::setChunkSize(std::size_t aChunkSize) {
+	chunkSize = (aChunkSize == 0) ? 1 : aChunkSize;
+}
+
+void ShardedProcess::setConcurrencyController(ConcurrencyController* aConcurrencyController) {
+	concurrencyController = aConcurrencyController;
+}
+
+int ShardedProcess::execute(process::FileDescriptor& input, process::Consumer& consumer) {
+	Shards shards;
+
+	/* input is read by a thread of its own, so a slow input does not block workers and the merge below */
+	auto reader = [this, &shards, &input]() {
+		std::string remainder;
+		bool inputEnd = false;
+
+		try {
+			while(true) {
+				{
+					std::unique_lock<std::mutex> lock(shards.mutex);
+
+					/* don't read more than 2 chunks per worker ahead of the consumer */
+					while(!shards.aborted && shards.readChunks >= shards.nextResult + 2 * workers) {
+						shards.condition.wait(lock);
+					}
+					if(shards.aborted) {
+						break;
+					}
+				}
+
+				std::string chunk;
+				bool hasChunk = readChunk(shards, input, remainder, inputEnd, chunk, delimiter, chunkSize);
+
+				std::lock_guard<std::mutex> lock(shards.mutex);
+				if(!hasChunk) {
+					break;
+				}
+				shards.chunks.push_back(std::move(chunk));
+				++shards.readChunks;
+				shards.condition.notify_all();
+			}
+		}
+		catch(...) {
+			std::lock_guard<std::mutex> lock(shards.mutex);
+			if(!shards.exception) {
+				shards.exception = std::current_exception();
+			}
+			abort(shards);
+		}
+
+		std::lock_guard<std::mutex> lock(shards.mutex);
+		shards.inputEnd = true;
+		shards.condition.notify_all();
+	};
+
+	auto worker = [this, &shards]() {
+		while(true) {
+			std::size_t index;
+			std::string chunk;
+
+			{
+				std::unique_lock<std::mutex> lock(shards.mutex);
+
+				while(!shards.aborted && shards.chunks.empty() && !shards.inputEnd) {
+					shards.condition.wait(lock);
+				}
+
+				if(shards.aborted || shards.chunks.empty()) {
+					++shards.finishedWorkers;
+					shards.condition.notify_all();
+					return;
+				}
+				chunk = std::move(shards.chunks.front());
+				shards.chunks.pop_front();
+				index = shards.nextChunk++;
+			}
+
+			try {
+				ConcurrencyController::Slot slot;
+				if(concurrencyController) {
+					slot = concurrencyController->acquire();
+				}
+
+				Process process(arguments);
+				process.setWorkingDir(workingDir);
+				if(hasEnvironment) {
+					process.setEnvironment(std::unique_ptr<process::Environment>(new process::Environment(environment)));
+				}
+
+				/* pass the chunk in small pieces, a blocking write of the whole chunk could deadlock
+				 * with the child that is waiting for its output being consumed. */
+				std::size_t chunkPos = 0;
+				process::ProducerDynamic producer([&chunk, &chunkPos](char* buffer, std::size_t size) {
+					std::size_t count = std::min(size, chunk.size() - chunkPos);
+					std::memcpy(buffer, &chunk[chunkPos], count);
+					chunkPos += count;
+					return count;
+				});
+				process::ConsumerString output;
+				ChildFeature childFeature(shards);
+				int rc = process.execute(producer, process::FileDescriptor::stdInHandle, output, process::FileDescriptor::stdOutHandle, process::FileDescriptor::stdErrHandle, childFeature);
+
+				std::lock_guard<std::mutex> lock(shards.mutex);
+				shards.results[index] = std::make_pair(rc, std::move(output).getString());
+				shards.condition.notify_all();
+			}
+			catch(...) {
+				std::lock_guard<std::mutex> lock(shards.mutex);
+				if(!shards.exception) {
+					shards.exception = std::current_exception();
+				}
+				abort(shards);
+				++shards.finishedWorkers;
+				return;
+			}
+		}
+	};
+
+	std::thread readerThread(reader);
+	std::vector<std::thread> threads;
+	for(std::size_t i = 0; i < workers; ++i) {
+		threads.emplace_back(worker);
+	}
+
+	process::ConsumerFeeder consumerFeeder(consumer);
+	int rc = 0;
+
+	while(true) {
+		std::pair<int, std::string> result;
+
+		{
+			std::unique_lock<std::mutex> lock(shards.mutex);
+
+			std::map<std::size_t, std::pair<int, std::string>>::iterator iter;
+			while(true) {
+				iter = shards.results.find(shards.nextResult);
+				if(shards.aborted || iter != std::end(shards.results) || shards.finishedWorkers == workers) {
+					break;
+				}
+				shards.condition.wait(lock);
+			}
+
+			if(shards.aborted || iter == std::end(shards.results)) {
+				break;
+			}
+
+			result = std::move(iter->second);
+			shards.results.erase(iter);
+			++shards.nextResult;
+			shards.condition.notify_all();
+		}
+
+		if(rc == 0) {
+			rc = result.first;
+		}
+
+		if(!consumerFeeder.feed(result.second.data(), result.second.size())) {
+			/* consumer does not want more data */
+			std::lock_guard<std::mutex> lock(shards.mutex);
+			abort(shards);
+			break;
+		}
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
+	}
+	readerThread.join();
+	consumerFeeder.close();
+
+	if(shards.exception) {
+		std::rethrow_exception(shards.exception);
+	}
+
+	return rc;
+}
+
+} /* namespace zsystem */
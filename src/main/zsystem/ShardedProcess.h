@@ -0,0 +1,85 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_SHARDEDPROCESS_H_
+#define ZSYSTEM_SHARDEDPROCESS_H_
+
+#include <zsystem/ConcurrencyController.h>
+#include <zsystem/process/Arguments.h>
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace zsystem {
+
+/* ShardedProcess runs a stateless filter (e.g. "sed", "jq", ...) on N cores.
+ *
+ * The input is read by a thread of its own and split at record boundaries (delimiter) into chunks of about
+ * "chunkSize" bytes. Up to N worker threads run one child per chunk concurrently. The outputs are passed in the
+ * original order of the chunks to the consumer.
+ *
+ * Note: The children are NOT N persistent children fed with many chunks. A new child is started per chunk,
+ * because only then the end of its output marks the end of the output of its chunk, whatever the filter does.
+ * So the cost of starting a child is paid per chunk, choose chunkSize large enough to amortize it.
+ *
+ * If the consumer does not want more data or something has failed, the children that are running are killed
+ * by SIGKILL, so execute returns without waiting for their chunks.
+ *
+ * Stderr of the children is not closed.
+ */
+class ShardedProcess {
+public:
+	ShardedProcess(process::Arguments arguments, std::size_t workers);
+
+	void setWorkingDir(std::string workingDir);
+	void setEnvironment(std::vector<std::pair<std::string, std::string>> environment);
+
+	void setDelimiter(char delimiter);
+	void setChunkSize(std::size_t chunkSize);
+
+	/* optional: every child acquires a slot of the concurrency controller before it is executed */
+	void setConcurrencyController(ConcurrencyController* concurrencyController);
+
+	/* return: 0 if all children returned 0, otherwise the return code of the first chunk that failed. */
+	int execute(process::FileDescriptor& input, process::Consumer& consumer);
+
+private:
+	process::Arguments arguments;
+	std::size_t workers;
+
+	std::string workingDir;
+	bool hasEnvironment = false;
+	std::vector<std::pair<std::string, std::string>> environment;
+
+	char delimiter = '\n';
+	std::size_t chunkSize = 1024 * 1024;
+
+	ConcurrencyController* concurrencyController = nullptr;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_SHARDEDPROCESS_H_ */
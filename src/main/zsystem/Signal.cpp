@@ -23,70 +23,113 @@ SOFTWARE.
 #include <zsystem/Signal.h>
 
 #include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 namespace zsystem {
 
+namespace {
+int toSignal(Signal::Type signal) noexcept {
+	switch(signal) {
+	case Signal::Type::hangUp:
+		return SIGHUP;
+	case Signal::Type::interrupt:
+		return SIGINT;
+	case Signal::Type::quit:
+		return SIGQUIT;
+	case Signal::Type::ill:
+		return SIGILL;
+	case Signal::Type::trap:
+		return SIGTRAP;
+	case Signal::Type::abort:
+		return SIGABRT;
+	case Signal::Type::busError:
+		return SIGBUS;
+	case Signal::Type::floatingPointException:
+		return SIGFPE;
+	case Signal::Type::user1:
+		return SIGUSR1;
+	case Signal::Type::segmentationViolation:
+		return SIGSEGV;
+	case Signal::Type::user2:
+		return SIGUSR2;
+	case Signal::Type::pipe:
+		return SIGPIPE;
+	case Signal::Type::alarm:
+		return SIGALRM;
+	case Signal::Type::stackFault:
+		return SIGSTKFLT;
+	case Signal::Type::terminate:
+		return SIGTERM;
+	case Signal::Type::child:
+		return SIGCHLD;
+	case Signal::Type::kill:
+		return SIGKILL;
+	case Signal::Type::stop:
+		return SIGSTOP;
+	case Signal::Type::cont:
+		return SIGCONT;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+} /* namespace {anonymous} */
 
 void Signal::sendSignal(Process::Handle handle, Type signal) {
 	if(handle == Process::noHandle) {
 		return;
 	}
 
-	switch(signal) {
-	case Type::hangUp:
-		kill(handle, SIGHUP);
-		break;
-	case Type::interrupt:
-		kill(handle, SIGINT);
-		break;
-	case Type::quit:
-		kill(handle, SIGQUIT);
-		break;
-	case Type::ill:
-		kill(handle, SIGILL);
-		break;
-	case Type::trap:
-		kill(handle, SIGTRAP);
-		break;
-	case Type::abort:
-		kill(handle, SIGABRT);
-		break;
-	case Type::busError:
-		kill(handle, SIGBUS);
-		break;
-	case Type::floatingPointException:
-		kill(handle, SIGFPE);
-		break;
-	case Type::user1:
-		kill(handle, SIGUSR1);
-		break;
-	case Type::segmentationViolation:
-		kill(handle, SIGSEGV);
-		break;
-	case Type::user2:
-		kill(handle, SIGUSR2);
-		break;
-	case Type::pipe:
-		kill(handle, SIGPIPE);
-		break;
-	case Type::alarm:
-		kill(handle, SIGALRM);
-		break;
-	case Type::stackFault:
-		kill(handle, SIGSTKFLT);
-		break;
-	case Type::terminate:
-		kill(handle, SIGTERM);
-		break;
-	case Type::child:
-		kill(handle, SIGCHLD);
-		break;
-	case Type::kill:
-		kill(handle, SIGKILL);
-		break;
-	default:
-		break;
+	int sig = toSignal(signal);
+	if(sig != 0) {
+		kill(handle, sig);
+	}
+}
+
+void Signal::sendGroupSignal(Process::Handle group, Type signal) {
+	if(group == Process::noHandle || group <= 1) {
+		return;
+	}
+
+	int sig = toSignal(signal);
+	if(sig != 0) {
+		kill(-group, sig);
 	}
 }
 
+void Signal::sendSignal(const Process& process, Type signal) {
+	sendSignal(process.getHandle(), process.getPidFileDescriptor().getHandle(), false, signal);
+}
+
+void Signal::sendGroupSignal(const Process& process, Type signal) {
+	sendSignal(process.getHandle(), process.getPidFileDescriptor().getHandle(), true, signal);
+}
+
+void Signal::sendSignal(Process::Handle handle, process::FileDescriptor::Handle pidHandle, bool group, Type signal) noexcept {
+	int sig = toSignal(signal);
+	if(handle == Process::noHandle || sig == 0) {
+		return;
+	}
+
+	/* never signal the group of the parent */
+	if(group && getpgid(handle) != handle) {
+		group = false;
+	}
+
+#ifdef SYS_pidfd_send_signal
+	if(pidHandle != process::FileDescriptor::noHandle) {
+		/* PIDFD_SIGNAL_PROCESS_GROUP, Linux >= 6.9 */
+		unsigned int flags = group ? (1U << 2) : 0;
+		if(syscall(SYS_pidfd_send_signal, pidHandle, sig, nullptr, flags) == 0 || !group || errno != EINVAL) {
+			return;
+		}
+	}
+#endif
+
+	kill(group ? -handle : handle, sig);
+}
+
 } /* namespace zsystem */
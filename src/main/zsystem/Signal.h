@@ -47,13 +47,29 @@ public:
 		stackFault,
 	    terminate,
 	    pipe,
-		kill
+		kill,
+		stop,
+		cont
 	};
 
 	Signal() = delete;
 	~Signal() = delete;
 
 	static void sendSignal(Process::Handle handle, Type signal);
+
+	/* signals all processes of a process group */
+	static void sendGroupSignal(Process::Handle group, Type signal);
+
+	/* Signals a child that has been started by Process::start(). The pidfd of the child is used if available,
+	 * so a child that has been reaped already can never be confused with a new process that got the same pid. */
+	static void sendSignal(const Process& process, Type signal);
+
+	/* Signals the whole process group of a child that has been started with Process::Group::processGroup or
+	 * Process::Group::session by one system call. Signals the child only if it is not the leader of its group. */
+	static void sendGroupSignal(const Process& process, Type signal);
+
+	/* common implementation, pidHandle is the pidfd of the process or FileDescriptor::noHandle */
+	static void sendSignal(Process::Handle handle, process::FileDescriptor::Handle pidHandle, bool group, Type signal) noexcept;
 };
 
 } /* namespace zsystem */
@@ -79,7 +79,7 @@ std::map<Signal::Type, InstalledSignalHandlers*> installedSignalHandlersByType =
 		{Signal::Type::alarm,                  &installedSignalHandlersAlarm},
 		{Signal::Type::stackFault,             &installedSignalHandlersStackFault},
 		{Signal::Type::terminate,              &installedSignalHandlersTerminate},
-		{Signal::Type::child,                  &installedSignalHandlersIll}
+		{Signal::Type::child,                  &installedSignalHandlersChild}
 };
 
 InstalledSignalHandlers* signalTypeToInstalledSignalHandlers(Signal::Type signalType) {
@@ -106,8 +106,13 @@ SignalHandler::Handle::~Handle() {
 }
 
 SignalHandler::Handle& SignalHandler::Handle::operator=(SignalHandler::Handle&& handle) {
-	signalHandler = handle.signalHandler;
-	handle.signalHandler = nullptr;
+	if(this != &handle) {
+		if(signalHandler) {
+			SignalHandler::remove(*signalHandler);
+		}
+		signalHandler = handle.signalHandler;
+		handle.signalHandler = nullptr;
+	}
 
 	return *this;
 }
@@ -128,11 +133,18 @@ SignalHandler::Handle SignalHandler::install(Signal::Type signalType, std::funct
     	installedSignalHandlers->sigActionInstalled.sa_handler = saHandler;
         sigemptyset(&installedSignalHandlers->sigActionInstalled.sa_mask);
 
+        if(signalType == Signal::Type::child) {
+        	/* SIGCHLD arrives for every terminated child, e.g. to wake up the Reaper.
+        	 * It must not interrupt system calls of other threads and stopped children are not of interest. */
+        	installedSignalHandlers->sigActionInstalled.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+        }
+        else {
 #ifdef SA_INTERRUPT
-        installedSignalHandlers->sigActionInstalled.sa_flags = SA_INTERRUPT;
+        	installedSignalHandlers->sigActionInstalled.sa_flags = SA_INTERRUPT;
 #else
-        installedSignalHandlers->sigActionInstalled.sa_flags = SA_RESTART;
+        	installedSignalHandlers->sigActionInstalled.sa_flags = SA_RESTART;
 #endif
+        }
         bool failure = (sigaction(installedSignalHandlers->signalNumber, &installedSignalHandlers->sigActionInstalled, &installedSignalHandlers->sigActionOriginal) != 0);
         if(failure) {
             throw std::runtime_error("Installation of signal handler failed for signal number " + std::to_string(installedSignalHandlers->signalNumber));
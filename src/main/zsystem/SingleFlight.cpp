@@ -0,0 +1,127 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/SingleFlight.h>
+#include <zsystem/process/ConsumerFeeder.h>
+#include <zsystem/process/ConsumerString.h>
+
+namespace zsystem {
+
+SingleFlight::SingleFlight(ProcessCache* aProcessCache)
+: processCache(aProcessCache)
+{ }
+
+int SingleFlight::execute(Process& process, ProcessKey& key, process::Producer* input, process::Consumer* output, process::Consumer* error) {
+	const std::string& hash = key.getHash();
+	std::shared_ptr<Flight> flight;
+	bool coalesced = false;
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		auto iter = flights.find(hash);
+		if(iter != flights.end()) {
+			flight = iter->second;
+			coalesced = true;
+			++metrics.coalesced;
+
+			while(!flight->done) {
+				condition.wait(lock);
+			}
+		}
+		else {
+			flight = std::make_shared<Flight>();
+			flights[hash] = flight;
+			++metrics.executions;
+		}
+	}
+
+	if(coalesced) {
+		return replay(*flight, output, error);
+	}
+
+	int rc = 0;
+	process::ConsumerString outputString;
+	process::ConsumerString errorString;
+	std::exception_ptr exception;
+
+	try {
+		if(processCache) {
+			rc = processCache->execute(process, key, input, &outputString, &errorString);
+		}
+		else {
+			Process::ParameterStreams parameterStreams;
+			if(input) {
+				parameterStreams[process::FileDescriptor::stdInHandle].producer = input;
+			}
+			parameterStreams[process::FileDescriptor::stdOutHandle].consumer = &outputString;
+			parameterStreams[process::FileDescriptor::stdErrHandle].consumer = &errorString;
+
+			Process::ParameterFeatures parameterFeatures;
+			rc = process.execute(parameterStreams, parameterFeatures);
+		}
+	}
+	catch(...) {
+		exception = std::current_exception();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		flight->rc = rc;
+		flight->output = std::move(outputString.getString());
+		flight->error = std::move(errorString.getString());
+		flight->exception = exception;
+		flight->done = true;
+		flights.erase(hash);
+	}
+	condition.notify_all();
+
+	return replay(*flight, output, error);
+}
+
+SingleFlight::Metrics SingleFlight::getMetrics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return metrics;
+}
+
+int SingleFlight::replay(const Flight& flight, process::Consumer* output, process::Consumer* error) {
+	if(flight.exception) {
+		std::rethrow_exception(flight.exception);
+	}
+
+	if(output) {
+		process::ConsumerFeeder consumerFeeder(*output);
+		consumerFeeder.feed(flight.output.data(), flight.output.size());
+		consumerFeeder.close();
+	}
+	if(error) {
+		process::ConsumerFeeder consumerFeeder(*error);
+		consumerFeeder.feed(flight.error.data(), flight.error.size());
+		consumerFeeder.close();
+	}
+
+	return flight.rc;
+}
+
+} /* namespace zsystem */
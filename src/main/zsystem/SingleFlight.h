@@ -0,0 +1,90 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_SINGLEFLIGHT_H_
+#define ZSYSTEM_SINGLEFLIGHT_H_
+
+#include <zsystem/Process.h>
+#include <zsystem/ProcessCache.h>
+#include <zsystem/ProcessKey.h>
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/Producer.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace zsystem {
+
+/* SingleFlight coalesces concurrent executions with the same ProcessKey.
+ *
+ * The first thread executes its process and captures stdout and stderr. Threads calling execute() with
+ * the same key while this execution is running do not start a child, they wait for the result instead.
+ * Every thread gets the return code and the captured output passed to its own consumers.
+ * If the execution throws, the exception is rethrown in every waiting thread.
+ *
+ * Optionally the execution goes through a ProcessCache, so results are shared over time as well.
+ */
+class SingleFlight {
+public:
+	struct Metrics {
+		std::uint64_t executions = 0;
+		std::uint64_t coalesced = 0;
+	};
+
+	SingleFlight(ProcessCache* processCache = nullptr);
+	SingleFlight(const SingleFlight&) = delete;
+
+	SingleFlight& operator=(const SingleFlight&) = delete;
+
+	/* same parameters as ProcessCache::execute. "process" and "input" are not used if the call is coalesced. */
+	int execute(Process& process, ProcessKey& key, process::Producer* input, process::Consumer* output, process::Consumer* error);
+
+	Metrics getMetrics() const;
+
+private:
+	struct Flight {
+		bool done = false;
+		int rc = 0;
+		std::string output;
+		std::string error;
+		std::exception_ptr exception;
+	};
+
+	static int replay(const Flight& flight, process::Consumer* output, process::Consumer* error);
+
+	ProcessCache* processCache;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	std::map<std::string, std::shared_ptr<Flight>> flights;
+	Metrics metrics;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_SINGLEFLIGHT_H_ */
@@ -0,0 +1,312 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/Supervisor.h>
+#include <zsystem/Signal.h>
+#include <zsystem/process/Environment.h>
+
+#include <unistd.h>
+
+#include <stdexcept>
+
+namespace zsystem {
+
+Supervisor::Supervisor(process::Arguments aArguments, Settings aSettings)
+: arguments(std::move(aArguments)),
+  settings(std::move(aSettings))
+{ }
+
+Supervisor::~Supervisor() {
+	stop();
+}
+
+void Supervisor::setWorkingDir(std::string aWorkingDir) {
+	workingDir = std::move(aWorkingDir);
+}
+
+void Supervisor::setEnvironment(std::vector<std::pair<std::string, std::string>> aEnvironment) {
+	environment = std::move(aEnvironment);
+	hasEnvironment = true;
+}
+
+void Supervisor::start() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	if(running || thread.joinable()) {
+		throw std::runtime_error("Supervisor::start() failed: already started");
+	}
+
+	std::size_t count = (settings.workers == 0) ? 1 : settings.workers;
+	workers.clear();
+	workers.resize(count);
+
+	if(!settings.unixPath.empty()) {
+		if(settings.mode == Mode::reusePort) {
+			throw std::runtime_error("Supervisor::start() failed: Mode::reusePort is not supported for UNIX sockets");
+		}
+
+		process::FileDescriptor listener = process::FileDescriptor::openUnixSocketListener(settings.unixPath, settings.backlog);
+		for(auto& worker : workers) {
+			worker.listener = listener.duplicate();
+		}
+	}
+	else if(settings.mode == Mode::shared) {
+		process::FileDescriptor listener = process::FileDescriptor::openTcpSocketListener(settings.address, settings.port, settings.backlog, false);
+		for(auto& worker : workers) {
+			worker.listener = listener.duplicate();
+		}
+	}
+	else {
+		for(auto& worker : workers) {
+			worker.listener = process::FileDescriptor::openTcpSocketListener(settings.address, settings.port, settings.backlog, true);
+		}
+	}
+
+	running = true;
+	started = false;
+	startException = nullptr;
+	thread = std::thread(&Supervisor::run, this);
+
+	while(!started && !startException) {
+		condition.wait(lock);
+	}
+
+	if(startException) {
+		lock.unlock();
+		thread.join();
+		workers.clear();
+		if(!settings.unixPath.empty()) {
+			unlink(settings.unixPath.c_str());
+		}
+		std::rethrow_exception(startException);
+	}
+}
+
+void Supervisor::stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+		condition.notify_all();
+	}
+
+	if(thread.joinable()) {
+		thread.join();
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!workers.empty()) {
+		workers.clear();
+		if(!settings.unixPath.empty()) {
+			unlink(settings.unixPath.c_str());
+		}
+	}
+}
+
+void Supervisor::rollingRestart() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	if(!running) {
+		throw std::runtime_error("Supervisor::rollingRestart() failed: not started");
+	}
+
+	std::uint64_t rollingRestart = ++rollingRestartsRequested;
+	condition.notify_all();
+
+	while(running && rollingRestartsDone < rollingRestart) {
+		condition.wait(lock);
+	}
+}
+
+Supervisor::Metrics Supervisor::getMetrics() const {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Metrics result = metrics;
+	result.running = 0;
+	for(const auto& worker : workers) {
+		if(worker.process) {
+			++result.running;
+		}
+	}
+
+	return result;
+}
+
+std::vector<Process::Handle> Supervisor::getHandles() const {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	std::vector<Process::Handle> handles;
+	for(const auto& worker : workers) {
+		if(worker.process) {
+			handles.push_back(worker.process->getHandle());
+		}
+	}
+
+	return handles;
+}
+
+void Supervisor::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+
+	try {
+		for(auto& worker : workers) {
+			startWorker(worker);
+		}
+		for(auto& worker : workers) {
+			if(!waitReady(*worker.process, lock)) {
+				throw std::runtime_error("Supervisor::start() failed: worker " + std::to_string(worker.process->getHandle()) + " is not ready within readyTimeout");
+			}
+		}
+	}
+	catch(...) {
+		startException = std::current_exception();
+		for(auto& worker : workers) {
+			if(worker.process) {
+				stopProcess(*worker.process, lock);
+				worker.process.reset();
+			}
+		}
+		running = false;
+		condition.notify_all();
+		return;
+	}
+
+	started = true;
+	condition.notify_all();
+
+	while(running) {
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		for(auto& worker : workers) {
+			int rc;
+			if(worker.process && worker.process->tryWait(rc)) {
+				worker.process.reset();
+				++metrics.restarts;
+			}
+
+			if(!worker.process && now - worker.lastStart >= settings.restartDelay) {
+				try {
+					startWorker(worker);
+				}
+				catch(...) {
+					/* try again next time */
+					worker.lastStart = now;
+				}
+			}
+		}
+
+		if(rollingRestartsDone < rollingRestartsRequested) {
+			std::uint64_t rollingRestart = rollingRestartsRequested;
+
+			for(auto& worker : workers) {
+				if(!running) {
+					break;
+				}
+
+				std::unique_ptr<Process> oldProcess = std::move(worker.process);
+				try {
+					startWorker(worker);
+				}
+				catch(...) {
+					worker.process = std::move(oldProcess);
+					continue;
+				}
+
+				if(!waitReady(*worker.process, lock)) {
+					stopProcess(*worker.process, lock);
+					worker.process = std::move(oldProcess);
+					continue;
+				}
+
+				if(oldProcess) {
+					stopProcess(*oldProcess, lock);
+				}
+			}
+
+			rollingRestartsDone = rollingRestart;
+			condition.notify_all();
+		}
+
+		condition.wait_for(lock, settings.checkInterval);
+	}
+
+	for(auto& worker : workers) {
+		if(worker.process) {
+			stopProcess(*worker.process, lock);
+			worker.process.reset();
+		}
+	}
+	condition.notify_all();
+}
+
+void Supervisor::startWorker(Worker& worker) {
+	std::unique_ptr<Process> process(new Process(arguments));
+
+	process->setWorkingDir(workingDir);
+	if(settings.notifyHandle != process::FileDescriptor::noHandle) {
+		process->setNotify(settings.notifyHandle);
+	}
+	if(hasEnvironment) {
+		process->setEnvironment(std::unique_ptr<process::Environment>(new process::Environment(environment)));
+	}
+
+	Process::ChildFileDescriptors childFileDescriptors;
+	childFileDescriptors[process::FileDescriptor::stdOutHandle];
+	childFileDescriptors[process::FileDescriptor::stdErrHandle];
+	childFileDescriptors[settings.listenHandle] = worker.listener.duplicate();
+
+	process->start(std::move(childFileDescriptors));
+
+	worker.process = std::move(process);
+	worker.lastStart = std::chrono::steady_clock::now();
+	++metrics.starts;
+}
+
+bool Supervisor::waitReady(Process& process, std::unique_lock<std::mutex>& lock) {
+	if(settings.notifyHandle == process::FileDescriptor::noHandle) {
+		return true;
+	}
+
+	/* only this thread modifies the workers, so it is safe to wait without lock */
+	lock.unlock();
+	bool ready = process.waitReady(settings.readyTimeout);
+	lock.lock();
+
+	return ready;
+}
+
+void Supervisor::stopProcess(Process& process, std::unique_lock<std::mutex>& lock) {
+	Signal::sendSignal(process, Signal::Type::terminate);
+
+	std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + settings.stopTimeout;
+	int rc;
+	while(!process.tryWait(rc)) {
+		if(std::chrono::steady_clock::now() >= timeout) {
+			Signal::sendSignal(process, Signal::Type::kill);
+			process.wait();
+			break;
+		}
+		condition.wait_for(lock, std::chrono::milliseconds(10));
+	}
+}
+
+} /* namespace zsystem */
@@ -0,0 +1,156 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_SUPERVISOR_H_
+#define ZSYSTEM_SUPERVISOR_H_
+
+#include <zsystem/Process.h>
+#include <zsystem/process/Arguments.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace zsystem {
+
+/* Supervisor keeps exactly N preforked workers alive that accept connections on a listening socket.
+ *
+ * The listening socket is created once and passed to every worker at the fixed handle "listenHandle".
+ * - Mode::shared:    all workers accept on the same socket (UNIX or TCP).
+ * - Mode::reusePort: every worker gets its own TCP socket bound with SO_REUSEPORT to the same port,
+ *                    so the kernel spreads the connections over the workers.
+ *
+ * If notifyHandle is set, workers get a readiness channel at this handle (see Process::setNotify).
+ * start() returns after the workers are ready and throws if a worker is not ready within readyTimeout.
+ * A rolling restart stops an old worker only after its replacement is ready. A replacement that is not ready within readyTimeout is stopped and the old worker is kept.
+ *
+ * Workers are started, restarted and stopped by a thread of the supervisor. So they are terminated
+ * (see Process::setTerminateOnParentDeath) if the supervisor is gone. Stdin of the workers is closed,
+ * stdout and stderr are not closed.
+ */
+class Supervisor {
+public:
+	enum class Mode {
+		shared,
+		reusePort
+	};
+
+	struct Settings {
+		std::size_t workers = 1;
+		Mode mode = Mode::shared;
+
+		/* handle of the listening socket for the workers */
+		process::FileDescriptor::Handle listenHandle = 3;
+
+		/* listen on UNIX socket if unixPath is not empty, otherwise on TCP address and port */
+		std::string unixPath;
+		std::string address = "0.0.0.0";
+		std::uint16_t port = 0;
+		int backlog = 128;
+
+		/* interval to check for terminated workers */
+		std::chrono::milliseconds checkInterval = std::chrono::milliseconds(100);
+
+		/* minimum time between two starts of the same worker, avoids fork loops of crashing workers */
+		std::chrono::milliseconds restartDelay = std::chrono::milliseconds(1000);
+
+		/* handle of the readiness channel for the workers, disabled if noHandle */
+		process::FileDescriptor::Handle notifyHandle = process::FileDescriptor::noHandle;
+		std::chrono::milliseconds readyTimeout = std::chrono::milliseconds(10000);
+
+		/* time between SIGTERM and SIGKILL if a worker is stopped */
+		std::chrono::milliseconds stopTimeout = std::chrono::milliseconds(5000);
+	};
+
+	struct Metrics {
+		std::size_t running = 0;
+		std::uint64_t starts = 0;
+		std::uint64_t restarts = 0;
+	};
+
+	Supervisor(process::Arguments arguments, Settings settings);
+	Supervisor(const Supervisor&) = delete;
+	~Supervisor();
+
+	Supervisor& operator=(const Supervisor&) = delete;
+
+	/* must be called before start */
+	void setWorkingDir(std::string workingDir);
+	void setEnvironment(std::vector<std::pair<std::string, std::string>> environment);
+
+	/* creates the listening socket(s) and starts the workers.
+	 * If starting a worker fails or a worker is not ready in time, all workers are stopped and it throws. */
+	void start();
+
+	/* stops all workers and removes the listening socket(s) */
+	void stop();
+
+	/* replaces the workers one after another. A new worker is started before the old one is stopped. */
+	void rollingRestart();
+
+	Metrics getMetrics() const;
+	std::vector<Process::Handle> getHandles() const;
+
+private:
+	struct Worker {
+		process::FileDescriptor listener;
+		std::unique_ptr<Process> process;
+		std::chrono::steady_clock::time_point lastStart;
+	};
+
+	void run();
+	void startWorker(Worker& worker);
+	bool waitReady(Process& process, std::unique_lock<std::mutex>& lock);
+	void stopProcess(Process& process, std::unique_lock<std::mutex>& lock);
+
+	const process::Arguments arguments;
+	const Settings settings;
+
+	std::string workingDir;
+	bool hasEnvironment = false;
+	std::vector<std::pair<std::string, std::string>> environment;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	std::vector<Worker> workers;
+	Metrics metrics;
+
+	bool running = false;
+	bool started = false;
+	std::exception_ptr startException;
+	std::uint64_t rollingRestartsRequested = 0;
+	std::uint64_t rollingRestartsDone = 0;
+	std::thread thread;
+};
+
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_SUPERVISOR_H_ */
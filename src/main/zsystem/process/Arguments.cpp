@@ -22,7 +22,6 @@ SOFTWARE.
 
 #include <zsystem/process/Arguments.h>
 
-#include <vector>
 #include <utility>
 #include <cstring>
 
@@ -30,52 +29,48 @@ namespace zsystem {
 namespace process {
 
 Arguments::Arguments(const Arguments& other)
-: args(other.args),
-  argc(other.argc)
+: args(other.args)
 {
-	if(argc == 0) {
-		return;
-	}
-
-	argv = new char*[argc + 1];
-	for(std::size_t i = 0; i<argc; ++i) {
-		std::size_t length = std::strlen(other.argv[i]);
-		argv[i] = new char[length + 1];
-		std::memcpy(argv[i], other.argv[i], length + 1);
-	}
-	argv[argc] = nullptr;
+	copyArgv(other);
 }
 
 
 Arguments::Arguments(Arguments&& other)
 : args(std::move(other.args)),
   argc(other.argc),
-  argv(other.argv)
+  argv(other.argv),
+  memoryResource(other.memoryResource)
 {
 	other.argc = 0;
 	other.argv = nullptr;
 }
 
 Arguments::Arguments(std::string aArgs)
-: args(std::move(aArgs))
-{
-	std::vector<char*> arguments;
+: Arguments(std::move(aArgs), nullptr)
+{ }
 
-    for(const char* src = args.c_str(); *src != 0; ++argc) {
+Arguments::Arguments(std::string aArgs, MemoryResource* aMemoryResource)
+: args(std::move(aArgs)),
+  memoryResource(aMemoryResource)
+{
+	/* count the arguments first, so argv is allocated once */
+	for(const char* src = args.c_str(); *src != 0; ++argc) {
 		std::size_t length;
-
-		argumentSize(src, length);
-		arguments.push_back(new char[length + 1]);
-        src = argumentCopy(src, arguments[argc]);
+		src = argumentSize(src, length);
 	}
 
 	if(argc == 0) {
 		return;
 	}
 
-	argv = new char*[argc + 1];
+	argv = allocateArray<char*>(memoryResource, argc + 1);
+	const char* src = args.c_str();
 	for(std::size_t i = 0; i<argc; ++i) {
-		argv[i] = arguments[i];
+		std::size_t length;
+
+		argumentSize(src, length);
+		argv[i] = allocateArgument(length);
+		src = argumentCopy(src, argv[i]);
 	}
 	argv[argc] = nullptr;
 }
@@ -87,16 +82,15 @@ Arguments::Arguments(std::size_t aArgc, const char** aArgv)
 		return;
 	}
 
-	argv = new char*[argc + 1];
+	argv = allocateArray<char*>(memoryResource, argc + 1);
 	for(std::size_t i = 0; i<argc; ++i) {
 		/* TODO:
 		 * Actually this is wrong!
 		 * We have to escape the characters '\' and ' '.
 		 */
 		std::size_t length = std::strlen(aArgv[i]);
-		argv[i] = new char[length + 1];
-		argv[i][0] = 0;
-		std::strncat(argv[i], aArgv[i], length);
+		argv[i] = allocateArgument(length);
+		std::memcpy(argv[i], aArgv[i], length + 1);
 
 		if(i > 0) {
 			args += " ";
@@ -107,39 +101,17 @@ Arguments::Arguments(std::size_t aArgc, const char** aArgv)
 }
 
 Arguments::~Arguments() {
-    for(std::size_t i = 0; i<argc; ++i) {
-    	delete[] argv[i];
-    }
-    if(argv) {
-    	delete[] argv;
-    }
+	release();
 }
 
 Arguments& Arguments::operator=(const Arguments& other) {
 	if(this != &other) {
 		/* first delete own entries */
-	    for(std::size_t i = 0; i<argc; ++i) {
-	    	delete[] argv[i];
-	    }
-	    if(argv) {
-	    	delete[] argv;
-	    }
-
-		/* now copy entries */
+		release();
+
+		/* now copy entries, they are allocated from our own memory resource */
 		args = other.args;
-		argc = other.argc;
-		if(argc == 0) {
-			argv = nullptr;
-		}
-		else {
-			argv = new char*[argc + 1];
-			for(std::size_t i = 0; i<argc; ++i) {
-				std::size_t length = std::strlen(other.argv[i]);
-				argv[i] = new char[length + 1];
-				std::memcpy(argv[i], other.argv[i], length + 1);
-			}
-			argv[argc] = nullptr;
-		}
+		copyArgv(other);
 	}
 
 	return *this;
@@ -148,17 +120,13 @@ Arguments& Arguments::operator=(const Arguments& other) {
 Arguments& Arguments::operator=(Arguments&& other) {
 	if(this != &other) {
 		/* first delete own entries */
-	    for(std::size_t i = 0; i<argc; ++i) {
-	    	delete[] argv[i];
-	    }
-	    if(argv) {
-	    	delete[] argv;
-	    }
-
-		/* now move entries */
+		release();
+
+		/* now move entries, together with the memory resource they are allocated from */
 		args = std::move(other.args);
 		argc = other.argc;
 		argv = other.argv;
+		memoryResource = other.memoryResource;
 
 		other.argc = 0;
 		other.argv = nullptr;
@@ -179,6 +147,41 @@ char** Arguments::getArgv() const noexcept {
 	return argv;
 }
 
+MemoryResource* Arguments::getMemoryResource() const noexcept {
+	return memoryResource;
+}
+
+char* Arguments::allocateArgument(std::size_t length) {
+	return allocateArray<char>(memoryResource, length + 1);
+}
+
+void Arguments::copyArgv(const Arguments& other) {
+	argc = other.argc;
+	argv = nullptr;
+	if(argc == 0) {
+		return;
+	}
+
+	argv = allocateArray<char*>(memoryResource, argc + 1);
+	for(std::size_t i = 0; i<argc; ++i) {
+		std::size_t length = std::strlen(other.argv[i]);
+		argv[i] = allocateArgument(length);
+		std::memcpy(argv[i], other.argv[i], length + 1);
+	}
+	argv[argc] = nullptr;
+}
+
+void Arguments::release() noexcept {
+	for(std::size_t i = 0; i<argc; ++i) {
+		deallocateArray(memoryResource, argv[i], std::strlen(argv[i]) + 1);
+	}
+	if(argv) {
+		deallocateArray(memoryResource, argv, argc + 1);
+	}
+	argc = 0;
+	argv = nullptr;
+}
+
 const char* Arguments::argumentSize(const char* src, std::size_t& length) {
 	length = 0;
 
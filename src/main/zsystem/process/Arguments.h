@@ -23,6 +23,8 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_ARGUMENTS_H_
 #define ZSYSTEM_PROCESS_ARGUMENTS_H_
 
+#include <zsystem/MemoryResource.h>
+
 #include <string>
 
 namespace zsystem {
@@ -35,6 +37,9 @@ public:
 	Arguments(Arguments&& other);
 	Arguments(std::string args);
 	Arguments(std::size_t argc, const char** argv);
+
+	/* argv is allocated from memoryResource, see MemoryResource.h. A copy uses the default again. */
+	Arguments(std::string args, MemoryResource* memoryResource);
 	~Arguments();
 
 	Arguments& operator=(const Arguments& other);
@@ -44,13 +49,20 @@ public:
 	std::size_t getArgc() const noexcept;
 	char** getArgv() const noexcept;
 
+	MemoryResource* getMemoryResource() const noexcept;
+
 private:
 	static const char* argumentSize(const char* src, std::size_t& length);
 	static const char* argumentCopy(const char* src, char* dst);
 
+	char* allocateArgument(std::size_t length);
+	void copyArgv(const Arguments& other);
+	void release() noexcept;
+
 	std::string args;
 	std::size_t argc = 0;
 	char** argv = nullptr;
+	MemoryResource* memoryResource = nullptr;
 };
 
 } /* namespace process */
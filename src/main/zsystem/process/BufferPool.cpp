@@ -0,0 +1,172 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/BufferPool.h>
+
+#include <stdlib.h>
+
+#include <new>
+
+namespace zsystem {
+namespace process {
+
+constexpr std::size_t BufferPool::minBufferSize;
+constexpr std::size_t BufferPool::maxBufferSize;
+constexpr std::size_t BufferPool::alignment;
+
+ChunkSize::ChunkSize(std::size_t aMinSize, std::size_t aMaxSize) noexcept
+: minSize(aMinSize),
+  maxSize(aMaxSize),
+  size(aMinSize)
+{ }
+
+std::size_t ChunkSize::get() const noexcept {
+	return size;
+}
+
+void ChunkSize::update(std::size_t transferred) noexcept {
+	if(transferred >= size) {
+		if(size < maxSize) {
+			size = (size * 2 < maxSize) ? size * 2 : maxSize;
+		}
+	}
+	else if(transferred < size / 4) {
+		if(size > minSize) {
+			size = (size / 2 > minSize) ? size / 2 : minSize;
+		}
+	}
+}
+
+BufferPool::Buffer::Buffer(BufferPool& aPool, char* aData) noexcept
+: pool(&aPool),
+  data(aData)
+{ }
+
+BufferPool::Buffer::Buffer(Buffer&& other) noexcept
+: pool(other.pool),
+  data(other.data)
+{
+	other.pool = nullptr;
+	other.data = nullptr;
+}
+
+BufferPool::Buffer::~Buffer() {
+	release();
+}
+
+BufferPool::Buffer& BufferPool::Buffer::operator=(Buffer&& other) noexcept {
+	if(this != &other) {
+		release();
+		pool = other.pool;
+		data = other.data;
+		other.pool = nullptr;
+		other.data = nullptr;
+	}
+	return *this;
+}
+
+BufferPool::Buffer::operator bool() const noexcept {
+	return data != nullptr;
+}
+
+char* BufferPool::Buffer::getData() const noexcept {
+	return data;
+}
+
+std::size_t BufferPool::Buffer::getSize() const noexcept {
+	return data ? pool->bufferSize : 0;
+}
+
+void BufferPool::Buffer::release() noexcept {
+	if(pool && data) {
+		pool->release(data);
+	}
+	pool = nullptr;
+	data = nullptr;
+}
+
+BufferPool::BufferPool(std::size_t aBufferSize, std::size_t aMaxIdle)
+: bufferSize(aBufferSize),
+  maxIdle(aMaxIdle)
+{
+	/* release() must not allocate */
+	idle.reserve(maxIdle);
+}
+
+BufferPool::~BufferPool() {
+	for(char* data : idle) {
+		free(data);
+	}
+}
+
+BufferPool& BufferPool::getDefault(std::size_t size) {
+	/* up to 1 MiB idle memory per pool */
+	static BufferPool bufferPools[] = {
+			{ minBufferSize, 16 },
+			{ minBufferSize * 2, 8 },
+			{ minBufferSize * 4, 4 },
+			{ minBufferSize * 8, 2 },
+			{ maxBufferSize, 1 }
+	};
+
+	std::size_t index = 0;
+	while(index + 1 < sizeof(bufferPools) / sizeof(bufferPools[0]) && bufferPools[index].bufferSize < size) {
+		++index;
+	}
+	return bufferPools[index];
+}
+
+BufferPool::Buffer BufferPool::acquire() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(!idle.empty()) {
+			char* data = idle.back();
+			idle.pop_back();
+			return Buffer(*this, data);
+		}
+	}
+
+	void* data = nullptr;
+	if(posix_memalign(&data, alignment, bufferSize) != 0) {
+		throw std::bad_alloc();
+	}
+	return Buffer(*this, static_cast<char*>(data));
+}
+
+std::size_t BufferPool::getBufferSize() const noexcept {
+	return bufferSize;
+}
+
+void BufferPool::release(char* data) noexcept {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(idle.size() < maxIdle) {
+			idle.push_back(data);
+			return;
+		}
+	}
+	free(data);
+}
+
+} /* namespace process */
+} /* namespace zsystem */
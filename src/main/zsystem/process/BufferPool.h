@@ -0,0 +1,117 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_BUFFERPOOL_H_
+#define ZSYSTEM_PROCESS_BUFFERPOOL_H_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace zsystem {
+namespace process {
+
+/* BufferPool hands out large I/O buffers aligned to a cache line and keeps released buffers for reuse,
+ * so the I/O loop reads a whole pipe capacity per syscall without allocating per read
+ * and producers and consumers do not need to embed a buffer of their own. */
+class BufferPool {
+public:
+	/* default capacity of a pipe */
+	static constexpr std::size_t minBufferSize = 64 * 1024;
+	/* default of /proc/sys/fs/pipe-max-size */
+	static constexpr std::size_t maxBufferSize = 1024 * 1024;
+	static constexpr std::size_t alignment = 64;
+
+	class Buffer {
+	public:
+		Buffer() = default;
+		Buffer(const Buffer&) = delete;
+		Buffer(Buffer&& other) noexcept;
+		~Buffer();
+
+		Buffer& operator=(const Buffer&) = delete;
+		Buffer& operator=(Buffer&& other) noexcept;
+
+		explicit operator bool() const noexcept;
+
+		char* getData() const noexcept;
+		std::size_t getSize() const noexcept;
+
+		/* gives the buffer back to its pool */
+		void release() noexcept;
+
+	private:
+		friend class BufferPool;
+		Buffer(BufferPool& pool, char* data) noexcept;
+
+		BufferPool* pool = nullptr;
+		char* data = nullptr;
+	};
+
+	/* maxIdle: number of released buffers that are kept for reuse, more are freed */
+	BufferPool(std::size_t bufferSize = minBufferSize, std::size_t maxIdle = 16);
+	BufferPool(const BufferPool&) = delete;
+	~BufferPool();
+
+	BufferPool& operator=(const BufferPool&) = delete;
+
+	/* Pools used by the library, one per power of two from minBufferSize to maxBufferSize.
+	 * Returns the pool with the smallest buffers of at least size bytes, limited to maxBufferSize.
+	 * Pools are thread safe, buffers can be released by any thread. */
+	static BufferPool& getDefault(std::size_t size = minBufferSize);
+
+	Buffer acquire();
+
+	std::size_t getBufferSize() const noexcept;
+
+private:
+	void release(char* data) noexcept;
+
+	const std::size_t bufferSize;
+	const std::size_t maxIdle;
+	std::mutex mutex;
+	std::vector<char*> idle;
+};
+
+/* ChunkSize adapts the number of bytes moved per syscall. It doubles while transfers fill the whole chunk,
+ * e.g. if a pipe with a raised capacity (see FileDescriptor::setPipeSize) has more data, and it halves
+ * if transfers use less than a quarter of it. */
+class ChunkSize {
+public:
+	ChunkSize(std::size_t minSize = BufferPool::minBufferSize, std::size_t maxSize = BufferPool::maxBufferSize) noexcept;
+
+	std::size_t get() const noexcept;
+
+	/* transferred: bytes moved by the last syscall with a chunk of get() bytes */
+	void update(std::size_t transferred) noexcept;
+
+private:
+	const std::size_t minSize;
+	const std::size_t maxSize;
+	std::size_t size;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_BUFFERPOOL_H_ */
@@ -30,11 +30,34 @@ SOFTWARE.
 namespace zsystem {
 namespace process {
 
+class ConsumerSpan;
+
 class Consumer {
 public:
 	virtual ~Consumer() = default;
 
+	/* return: false if no more data is desired, true otherwise.
+	 *         fileDescriptor might be non-blocking, so read() can return FileDescriptor::wouldBlock.
+	 *         That is not an error, the consumer is called again when there is new data. */
 	virtual bool consume(FileDescriptor& fileDescriptor) = 0;
+
+	/* called at end of file, before the consumer is dropped, and if the handle of getPendingHandle() is writable.
+	 * return: false if data is still pending, e.g. because the target of the consumer is full.
+	 *         It is called again by the next iteration then. */
+	virtual bool flushPending() {
+		return true;
+	}
+
+	/* returns the handle of the target if it cannot take data now, noHandle otherwise.
+	 * Meanwhile the I/O loop does not call consume() but polls this handle for POLLOUT and calls flushPending(). */
+	virtual FileDescriptor::Handle getPendingHandle() const noexcept {
+		return FileDescriptor::noHandle;
+	}
+
+	/* returns the consumer itself if it takes its data as span, see ConsumerSpan */
+	virtual ConsumerSpan* getConsumerSpan() noexcept {
+		return nullptr;
+	}
 };
 
 } /* namespace process */
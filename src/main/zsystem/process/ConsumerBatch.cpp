@@ -0,0 +1,189 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/ConsumerBatch.h>
+
+#include <algorithm>
+
+namespace zsystem {
+namespace process {
+
+ConsumerBatch::ConsumerBatch(Consumer& consumer, std::size_t aLowWatermark, std::size_t aHighWatermark, std::chrono::milliseconds aMaxLatency)
+: consumerFeeder(consumer),
+  lowWatermark(aLowWatermark > 0 ? aLowWatermark : 1),
+  highWatermark(std::max(aHighWatermark, lowWatermark)),
+  maxLatency(aMaxLatency),
+  batchFeature(*this)
+{
+	/* collecting must not allocate */
+	buffer.reserve(highWatermark);
+}
+
+bool ConsumerBatch::consumeData(const char* data, std::size_t size) {
+	if(done) {
+		return false;
+	}
+
+	/* nothing collected and enough data: deliver without copying */
+	if(buffer.empty()) {
+		while(size >= lowWatermark) {
+			std::size_t count = std::min(size, highWatermark);
+			if(!deliver(data, count)) {
+				return false;
+			}
+			data += count;
+			size -= count;
+		}
+		if(size == 0) {
+			return true;
+		}
+		bufferTime = Clock::now();
+	}
+
+	while(size > 0) {
+		std::size_t count = std::min(size, highWatermark - buffer.size());
+		buffer.append(data, count);
+		data += count;
+		size -= count;
+
+		if(buffer.size() >= highWatermark) {
+			bool success = deliver(buffer.data(), buffer.size());
+			buffer.clear();
+			if(!success) {
+				return false;
+			}
+			bufferTime = Clock::now();
+		}
+	}
+
+	if(buffer.size() >= lowWatermark || (!buffer.empty() && Clock::now() - bufferTime >= maxLatency)) {
+		bool success = deliver(buffer.data(), buffer.size());
+		buffer.clear();
+		updateWakeup();
+		return success;
+	}
+
+	updateWakeup();
+	return true;
+}
+
+bool ConsumerBatch::flushPending() {
+	/* collected data is delivered by flush(), this is about data kept by the consumer */
+	return consumerFeeder.flushPending();
+}
+
+FileDescriptor::Handle ConsumerBatch::getPendingHandle() const noexcept {
+	return consumerFeeder.getPendingHandle();
+}
+
+Feature& ConsumerBatch::getFeature() noexcept {
+	return batchFeature;
+}
+
+void ConsumerBatch::flush() {
+	if(!buffer.empty()) {
+		deliver(buffer.data(), buffer.size());
+		buffer.clear();
+	}
+	consumerFeeder.close();
+	done = true;
+}
+
+std::size_t ConsumerBatch::getBatchCount() const noexcept {
+	return batchCount;
+}
+
+ConsumerBatch::BatchFeature::BatchFeature(ConsumerBatch& aConsumerBatch)
+: consumerBatch(aConsumerBatch)
+{ }
+
+void ConsumerBatch::BatchFeature::onBeforeFork(Context& context) {
+	consumerBatch.wakeup = &context.addWakeup();
+	consumerBatch.wakeupArmed = false;
+}
+
+void ConsumerBatch::BatchFeature::onIteration() {
+	consumerBatch.deliverExpired();
+}
+
+void ConsumerBatch::BatchFeature::onExit(int, const struct rusage&) {
+	consumerBatch.flush();
+	consumerBatch.wakeup = nullptr;
+}
+
+void ConsumerBatch::deliverExpired() {
+	Clock::time_point now = Clock::now();
+	if(wakeupArmed && now >= wakeupTime) {
+		/* has fired */
+		wakeupArmed = false;
+	}
+
+	if(!buffer.empty() && now - bufferTime >= maxLatency) {
+		deliver(buffer.data(), buffer.size());
+		buffer.clear();
+	}
+	updateWakeup();
+}
+
+void ConsumerBatch::updateWakeup() {
+	if(!wakeup) {
+		return;
+	}
+
+	if(buffer.empty() || done) {
+		if(wakeupArmed) {
+			wakeup->cancel();
+			wakeupArmed = false;
+		}
+		return;
+	}
+
+	Clock::time_point expiryTime = bufferTime + maxLatency;
+	if(wakeupArmed && wakeupTime == expiryTime) {
+		return;
+	}
+
+	Clock::duration delay = expiryTime - Clock::now();
+	std::chrono::milliseconds delayMs = std::chrono::duration_cast<std::chrono::milliseconds>(delay);
+	if(delayMs < delay) {
+		++delayMs;
+	}
+	wakeup->wakeAfter(delayMs);
+	wakeupTime = expiryTime;
+	wakeupArmed = true;
+}
+
+bool ConsumerBatch::deliver(const char* data, std::size_t size) {
+	if(done) {
+		return false;
+	}
+
+	++batchCount;
+	if(!consumerFeeder.feed(data, size)) {
+		done = true;
+	}
+	return !done;
+}
+
+} /* namespace process */
+} /* namespace zsystem */
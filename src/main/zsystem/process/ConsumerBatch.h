@@ -0,0 +1,105 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_CONSUMERBATCH_H_
+#define ZSYSTEM_PROCESS_CONSUMERBATCH_H_
+
+#include <zsystem/process/ConsumerSpan.h>
+#include <zsystem/process/ConsumerFeeder.h>
+#include <zsystem/process/Feature.h>
+
+#include <chrono>
+#include <string>
+
+namespace zsystem {
+namespace process {
+
+/* ConsumerBatch collects the output of chatty children and passes it to another consumer in batches.
+ *
+ * A batch is delivered if at least lowWatermark bytes are collected or if the oldest collected byte
+ * is older than maxLatency. A batch has at most highWatermark bytes.
+ * Pass getFeature() to Process::execute as well. Then the parent loop wakes up to deliver data
+ * after maxLatency even if the child writes nothing more, and the rest is delivered when the child has
+ * terminated. The wakeup is armed only while data is collected. Otherwise call flush() after execute.
+ * Like ConsumerFeeder it is used for one execution only.
+ *
+ * Only a ConsumerSpan gets one batch per call. A plain Consumer reads the batches from the pipe of the
+ * ConsumerFeeder, so it gets them split or joined again as its reads return. */
+class ConsumerBatch : public ConsumerSpan {
+public:
+	ConsumerBatch(Consumer& consumer, std::size_t lowWatermark, std::size_t highWatermark, std::chrono::milliseconds maxLatency);
+
+	bool consumeData(const char* data, std::size_t size) override;
+	bool flushPending() override;
+	FileDescriptor::Handle getPendingHandle() const noexcept override;
+
+	Feature& getFeature() noexcept;
+
+	/* delivers collected data and closes the ConsumerFeeder to the consumer */
+	void flush();
+
+	/* number of batches delivered to the consumer */
+	std::size_t getBatchCount() const noexcept;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	class BatchFeature : public Feature {
+	public:
+		BatchFeature(ConsumerBatch& consumerBatch);
+
+		void onBeforeFork(Context& context) override;
+		void onIteration() override;
+		void onExit(int status, const struct rusage& rusage) override;
+
+	private:
+		ConsumerBatch& consumerBatch;
+	};
+
+	/* delivers collected data if the oldest byte is older than maxLatency */
+	void deliverExpired();
+	bool deliver(const char* data, std::size_t size);
+
+	/* arms the wakeup to bufferTime + maxLatency while data is collected */
+	void updateWakeup();
+
+	ConsumerFeeder consumerFeeder;
+	const std::size_t lowWatermark;
+	const std::size_t highWatermark;
+	const std::chrono::milliseconds maxLatency;
+	BatchFeature batchFeature;
+
+	Feature::Context::Wakeup* wakeup = nullptr;
+	Clock::time_point wakeupTime;
+	bool wakeupArmed = false;
+
+	std::string buffer;
+	Clock::time_point bufferTime;
+	std::size_t batchCount = 0;
+	bool done = false;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_CONSUMERBATCH_H_ */
@@ -0,0 +1,119 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/ConsumerBudget.h>
+
+#include <cstring>
+
+namespace zsystem {
+namespace process {
+
+ConsumerBudget::ConsumerBudget(Unit aUnit, std::size_t aBudget, FeatureProcess* aFeatureProcess, char aDelimiter)
+: unit(aUnit),
+  budget(aBudget),
+  featureProcess(aFeatureProcess),
+  delimiter(aUnit == Unit::lines ? '\n' : aDelimiter)
+{ }
+
+void ConsumerBudget::setKill(bool aKill) noexcept {
+	kill = aKill;
+}
+
+void ConsumerBudget::setTerminateGroup(bool aTerminateGroup) noexcept {
+	terminateGroup = aTerminateGroup;
+}
+
+bool ConsumerBudget::consumeData(const char* data, std::size_t size) {
+	if(exhausted) {
+		return false;
+	}
+
+	if(unit == Unit::bytes) {
+		if(budget - used < size) {
+			/* take no more than needed */
+			size = budget - used;
+		}
+		used += size;
+		str.append(data, size);
+	}
+	else {
+		const char* begin = data;
+		const char* end = data + size;
+		while(used < budget && begin < end) {
+			const char* found = static_cast<const char*>(std::memchr(begin, delimiter, static_cast<std::size_t>(end - begin)));
+			if(found == nullptr) {
+				begin = end;
+				break;
+			}
+			++used;
+			begin = found + 1;
+		}
+		str.append(data, static_cast<std::size_t>(begin - data));
+	}
+
+	if(used >= budget) {
+		exhausted = true;
+		terminate();
+		return false;
+	}
+
+	return true;
+}
+
+bool ConsumerBudget::isExhausted() const noexcept {
+	return exhausted;
+}
+
+std::string& ConsumerBudget::getString() & {
+	return str;
+}
+
+std::string&& ConsumerBudget::getString() && {
+	return std::move(str);
+}
+
+void ConsumerBudget::terminate() {
+	if(featureProcess == nullptr) {
+		return;
+	}
+
+	if(terminateGroup) {
+		if(kill) {
+			featureProcess->killGroup();
+		}
+		else {
+			featureProcess->stopGroup();
+		}
+	}
+	else {
+		if(kill) {
+			featureProcess->kill();
+		}
+		else {
+			featureProcess->stop();
+		}
+	}
+}
+
+} /* namespace process */
+} /* namespace zsystem */
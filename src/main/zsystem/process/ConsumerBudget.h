@@ -0,0 +1,83 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_CONSUMERBUDGET_H_
+#define ZSYSTEM_PROCESS_CONSUMERBUDGET_H_
+
+#include <zsystem/process/ConsumerSpan.h>
+#include <zsystem/process/FeatureProcess.h>
+
+#include <string>
+
+namespace zsystem {
+namespace process {
+
+/* ConsumerBudget captures output like ConsumerString, but only up to a budget of bytes, lines or records.
+ *
+ * If the budget is reached, the captured output is cut exactly at the budget and consume() returns false,
+ * so the parent closes its side of the pipe. If a FeatureProcess is given, that is passed to
+ * Process::execute as well, the child is terminated immediately instead of running until it gets SIGPIPE. */
+class ConsumerBudget : public ConsumerSpan {
+public:
+	enum class Unit {
+		bytes,
+		lines,
+		records
+	};
+
+	/* delimiter is used for Unit::records only */
+	ConsumerBudget(Unit unit, std::size_t budget, FeatureProcess* featureProcess = nullptr, char delimiter = '\n');
+
+	/* send SIGKILL instead of SIGTERM (default: false) */
+	void setKill(bool kill) noexcept;
+
+	/* signal the process group of the child if the child is the leader of its own group (default: false) */
+	void setTerminateGroup(bool terminateGroup) noexcept;
+
+	bool consumeData(const char* data, std::size_t size) override;
+
+	/* returns true if the budget has been reached */
+	bool isExhausted() const noexcept;
+
+	std::string& getString() &;
+	std::string&& getString() &&;
+
+private:
+	void terminate();
+
+	const Unit unit;
+	const std::size_t budget;
+	FeatureProcess* featureProcess;
+	const char delimiter;
+	bool kill = false;
+	bool terminateGroup = false;
+
+	std::size_t used = 0;
+	bool exhausted = false;
+	std::string str;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_CONSUMERBUDGET_H_ */
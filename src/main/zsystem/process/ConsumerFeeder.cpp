@@ -0,0 +1,123 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/ConsumerFeeder.h>
+
+#include <errno.h>
+#include <poll.h>
+
+#include <utility>
+
+namespace zsystem {
+namespace process {
+
+ConsumerFeeder::ConsumerFeeder(Consumer& aConsumer)
+: consumer(aConsumer),
+  consumerSpan(aConsumer.getConsumerSpan())
+{
+	if(consumerSpan) {
+		return;
+	}
+
+	std::pair<FileDescriptor, FileDescriptor> fileDescriptors = FileDescriptor::openUnidirectional();
+	readFileDescriptor = std::move(fileDescriptors.first);
+	writeFileDescriptor = std::move(fileDescriptors.second);
+
+	/* writing must not block if the pipe is full, because we are the reader as well */
+	writeFileDescriptor.setBlocking(false);
+}
+
+bool ConsumerFeeder::feed(const char* data, std::size_t size) {
+	if(consumerSpan) {
+		if(!done && size > 0 && !consumerSpan->consumeData(data, size)) {
+			done = true;
+		}
+		return !done;
+	}
+
+	while(!done && size > 0) {
+		std::size_t count = writeFileDescriptor.write(data, size);
+		if(count == FileDescriptor::npos) {
+			done = true;
+			break;
+		}
+		if(count != FileDescriptor::wouldBlock) {
+			data += count;
+			size -= count;
+		}
+
+		/* pipe is full or data has been written. Now let the consumer read it. */
+		if(!pump()) {
+			done = true;
+		}
+	}
+
+	return !done;
+}
+
+bool ConsumerFeeder::flushPending() {
+	return consumer.flushPending();
+}
+
+FileDescriptor::Handle ConsumerFeeder::getPendingHandle() const noexcept {
+	return consumer.getPendingHandle();
+}
+
+void ConsumerFeeder::close() {
+	writeFileDescriptor.close();
+
+	if(!done) {
+		if(consumerSpan == nullptr) {
+			pump();
+		}
+		/* data that the consumer still cannot pass on stays with the consumer */
+		consumer.flushPending();
+		done = true;
+	}
+	readFileDescriptor.close();
+}
+
+bool ConsumerFeeder::pump() {
+	while(true) {
+		struct pollfd pollFd;
+		pollFd.fd = readFileDescriptor.getHandle();
+		pollFd.events = POLLIN;
+		pollFd.revents = 0;
+
+		int rc = poll(&pollFd, 1, 0);
+		if(rc == -1 && errno == EINTR) {
+			continue;
+		}
+		if(rc <= 0 || (pollFd.revents & POLLIN) == 0) {
+			/* pipe is empty */
+			return true;
+		}
+
+		if(!consumer.consume(readFileDescriptor)) {
+			return false;
+		}
+	}
+}
+
+} /* namespace process */
+} /* namespace zsystem */
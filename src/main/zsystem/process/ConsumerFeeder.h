@@ -0,0 +1,66 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_CONSUMERFEEDER_H_
+#define ZSYSTEM_PROCESS_CONSUMERFEEDER_H_
+
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/ConsumerSpan.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <string>
+
+namespace zsystem {
+namespace process {
+
+/* ConsumerFeeder passes data from memory to a Consumer.
+ * A Consumer reads its data from a FileDescriptor, so the data is passed through a pipe.
+ * A ConsumerSpan gets the data directly, then there is no pipe at all. */
+class ConsumerFeeder {
+public:
+	ConsumerFeeder(Consumer& consumer);
+
+	/* returns false if the consumer does not want more data */
+	bool feed(const char* data, std::size_t size);
+
+	/* passes data kept by the consumer on, see Consumer::flushPending() */
+	bool flushPending();
+	FileDescriptor::Handle getPendingHandle() const noexcept;
+
+	/* passes remaining data to the consumer and closes the pipe */
+	void close();
+
+private:
+	bool pump();
+
+	Consumer& consumer;
+	ConsumerSpan* consumerSpan;
+	FileDescriptor readFileDescriptor;
+	FileDescriptor writeFileDescriptor;
+	bool done = false;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_CONSUMERFEEDER_H_ */
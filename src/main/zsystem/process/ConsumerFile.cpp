@@ -30,31 +30,87 @@ ConsumerFile::ConsumerFile(FileDescriptor aFileDescriptor)
 { }
 
 bool ConsumerFile::consume(FileDescriptor& fileDescriptor) {
-	if(currentPos == process::FileDescriptor::npos) {
-		return false;
+	if(!flushPending() || failed) {
+		/* target is still full, data stays in the pipe until it takes data again */
+		return !failed;
 	}
 
-	if(currentPos >= currentSize) {
-		currentPos = 0;
-		currentSize = fileDescriptor.read(buffer, sizeof(buffer));
+	if(spliceSupported) {
+		std::size_t count = fileDescriptor.splice(getFileDescriptor(), BufferPool::maxBufferSize);
+		if(count == process::FileDescriptor::notSupported) {
+			spliceSupported = false;
+		}
+		else if(count == process::FileDescriptor::npos) {
+			failed = true;
+			return false;
+		}
+		else {
+			/* wouldBlock: pipe is empty or target is full, nothing has been moved.
+			 * end of file is detected by the I/O loop */
+			spliceBlocked = (count == process::FileDescriptor::wouldBlock);
+			return true;
+		}
 	}
 
-	if(currentSize == process::FileDescriptor::npos) {
-		currentPos = process::FileDescriptor::npos;
-		return false;
-		//return process::FileDescriptor::npos;
+	return ConsumerSpan::consume(fileDescriptor);
+}
+
+bool ConsumerFile::consumeData(const char* data, std::size_t size) {
+	if(!flushPending() || failed) {
+		if(failed) {
+			return false;
+		}
+		pending.append(data, size);
+		return true;
 	}
 
-	std::size_t count = getFileDescriptor().write(&buffer[currentPos], currentSize - currentPos);
-	if(count == process::FileDescriptor::npos) {
-		currentPos = process::FileDescriptor::npos;
-		return false;
+	while(size > 0) {
+		std::size_t count = getFileDescriptor().write(data, size);
+		if(count == process::FileDescriptor::wouldBlock) {
+			/* target is non-blocking and full, the buffer is not ours after this call */
+			pending.assign(data, size);
+			pendingPos = 0;
+			return true;
+		}
+		if(count == process::FileDescriptor::npos) {
+			failed = true;
+			return false;
+		}
+		data += count;
+		size -= count;
 	}
 
-	currentPos += count;
 	return true;
 }
 
+bool ConsumerFile::flushPending() {
+	spliceBlocked = false;
+
+	while(pendingPos < pending.size() && !failed) {
+		std::size_t count = getFileDescriptor().write(&pending[pendingPos], pending.size() - pendingPos);
+		if(count == process::FileDescriptor::wouldBlock) {
+			return false;
+		}
+		if(count == process::FileDescriptor::npos) {
+			failed = true;
+		}
+		else {
+			pendingPos += count;
+		}
+	}
+
+	pending.clear();
+	pendingPos = 0;
+	return true;
+}
+
+FileDescriptor::Handle ConsumerFile::getPendingHandle() const noexcept {
+	if(failed || (pendingPos >= pending.size() && !spliceBlocked)) {
+		return FileDescriptor::noHandle;
+	}
+	return fileDescriptor.getHandle();
+}
+
 FileDescriptor& ConsumerFile::getFileDescriptor() & {
 	return fileDescriptor;
 }
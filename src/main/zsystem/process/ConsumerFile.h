@@ -23,26 +23,41 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_CONSUMERFILE_H_
 #define ZSYSTEM_PROCESS_CONSUMERFILE_H_
 
-#include <zsystem/process/Consumer.h>
+#include <zsystem/process/ConsumerSpan.h>
+
+#include <string>
 
 namespace zsystem {
 namespace process {
 
-class ConsumerFile : public Consumer {
+/* ConsumerFile moves data from a pipe to the file by splice(2), without copying it to user space.
+ * If splice is not possible, e.g. data comes from a socket, it falls back to read and write.
+ * If the file is non-blocking and full, the rest is kept and written by the next call,
+ * nothing more is read until then. Meanwhile getPendingHandle() returns the file, so the I/O loop waits until
+ * it is writable instead of being woken up by the pipe again and again. */
+class ConsumerFile : public ConsumerSpan {
 public:
 	ConsumerFile(FileDescriptor fileDescriptor);
 
 	bool consume(FileDescriptor& fileDescriptor) override;
+	bool consumeData(const char* data, std::size_t size) override;
+	bool flushPending() override;
+	FileDescriptor::Handle getPendingHandle() const noexcept override;
 
 	FileDescriptor& getFileDescriptor() &;
 	FileDescriptor&& getFileDescriptor() &&;
 
 private:
 	FileDescriptor fileDescriptor;
+	bool failed = false;
+
+	/* data that could not be written yet, it keeps its capacity */
+	std::string pending;
+	std::size_t pendingPos = 0;
 
-	char buffer[4096];
-	std::size_t currentPos = 0;
-	std::size_t currentSize = 0;
+	/* splice would block, the file might be full */
+	bool spliceBlocked = false;
+	bool spliceSupported = true;
 };
 
 } /* namespace process */
@@ -0,0 +1,50 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/ConsumerSpan.h>
+
+namespace zsystem {
+namespace process {
+
+bool ConsumerSpan::consume(FileDescriptor& fileDescriptor) {
+	BufferPool::Buffer buffer = BufferPool::getDefault(chunkSize.get()).acquire();
+
+	std::size_t count = fileDescriptor.read(buffer.getData(), chunkSize.get());
+	if(count == FileDescriptor::npos) {
+		return false;
+	}
+	if(count == FileDescriptor::wouldBlock || count == 0) {
+		/* end of file is detected by the I/O loop, see Process::isEndOfFile */
+		return true;
+	}
+	chunkSize.update(count);
+
+	return consumeData(buffer.getData(), count);
+}
+
+ConsumerSpan* ConsumerSpan::getConsumerSpan() noexcept {
+	return this;
+}
+
+} /* namespace process */
+} /* namespace zsystem */
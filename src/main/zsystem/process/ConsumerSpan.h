@@ -0,0 +1,59 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_CONSUMERSPAN_H_
+#define ZSYSTEM_PROCESS_CONSUMERSPAN_H_
+
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/BufferPool.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <cstddef>
+
+namespace zsystem {
+namespace process {
+
+/* ConsumerSpan is a Consumer that does not read by itself.
+ * The library reads into a buffer of BufferPool::getDefault() and passes the data as span.
+ * The size of a read grows while reads fill the buffer, see ChunkSize.
+ * ConsumerFeeder passes data from memory directly, without a pipe in between. */
+class ConsumerSpan : public Consumer {
+public:
+	/* reads into a pooled buffer and calls consumeData().
+	 * Derived classes might override it to take data without a buffer, e.g. ConsumerFile. */
+	bool consume(FileDescriptor& fileDescriptor) override;
+
+	ConsumerSpan* getConsumerSpan() noexcept override final;
+
+	/* data is valid during this call only, size is never 0.
+	 * return: false if no more data is desired, true otherwise. */
+	virtual bool consumeData(const char* data, std::size_t size) = 0;
+
+private:
+	ChunkSize chunkSize;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_CONSUMERSPAN_H_ */
@@ -22,61 +22,58 @@ SOFTWARE.
 
 #include <zsystem/process/Environment.h>
 
+#include <unistd.h>
+
 #include <cstring>
 
 namespace zsystem {
 namespace process {
 
 Environment::Environment()
-: envc(0),
-  envp(new char*[1])
-{
-    envp[envc] = nullptr;
-}
+: Environment(static_cast<MemoryResource*>(nullptr))
+{ }
 
 Environment::Environment(Environment&& other)
 : envc(other.envc),
-  envp(other.envp)
+  envp(other.envp),
+  memoryResource(other.memoryResource)
 {
 	other.envc = 0;
 	other.envp = nullptr;
 }
 
-Environment::Environment(const std::vector<std::pair<std::string, std::string>>& values)
+Environment::Environment(MemoryResource* aMemoryResource)
+: envc(0),
+  envp(allocateArray<char*>(aMemoryResource, 1)),
+  memoryResource(aMemoryResource)
+{
+    envp[envc] = nullptr;
+}
+
+Environment::Environment(const std::vector<std::pair<std::string, std::string>>& values, MemoryResource* aMemoryResource)
 : envc(values.size()),
-  envp(new char*[envc + 1])
+  envp(allocateArray<char*>(aMemoryResource, values.size() + 1)),
+  memoryResource(aMemoryResource)
 {
     for(std::size_t i=0; i<envc; ++i) {
-    	std::string entry = values[i].first + "=" + values[i].second;
-		envp[i] = new char[entry.size() + 1];
-		envp[i][0] = 0;
-		std::strncat(envp[i], entry.c_str(), entry.size());
+		envp[i] = createEntry(values[i].first.data(), values[i].first.size(), values[i].second.data(), values[i].second.size());
     }
     envp[envc] = nullptr;
 }
 
 Environment::~Environment() {
-    for(std::size_t i = 0; i<envc; ++i) {
-    	delete[] envp[i];
-    }
-    if(envp) {
-    	delete[] envp;
-    }
+	release();
 }
 
 Environment& Environment::operator=(Environment&& other) {
 	if(this != &other) {
 		/* first delete own entries */
-	    for(std::size_t i = 0; i<envc; ++i) {
-	    	delete[] envp[i];
-	    }
-	    if(envp) {
-	    	delete[] envp;
-	    }
-
-		/* now move entries */
+		release();
+
+		/* now move entries, together with the memory resource they are allocated from */
 		envc = other.envc;
 		envp = other.envp;
+		memoryResource = other.memoryResource;
 
 		other.envc = 0;
 		other.envp = nullptr;
@@ -85,9 +82,88 @@ Environment& Environment::operator=(Environment&& other) {
 	return *this;
 }
 
+Environment Environment::copyCurrent(MemoryResource* memoryResource) {
+	return copyEntries(environ, memoryResource);
+}
+
+Environment Environment::copy() const {
+	return copyEntries(envp, memoryResource);
+}
+
+Environment Environment::copyEntries(char* const* entries, MemoryResource* memoryResource) {
+	std::size_t count = 0;
+	for(char* const* entry = entries; entry && *entry; ++entry) {
+		if(std::strchr(*entry, '=')) {
+			++count;
+		}
+	}
+
+	Environment environment(memoryResource);
+	deallocateArray(memoryResource, environment.envp, 1);
+	environment.envp = allocateArray<char*>(memoryResource, count + 1);
+
+	for(char* const* entry = entries; entry && *entry && environment.envc < count; ++entry) {
+		if(std::strchr(*entry, '=')) {
+			std::size_t size = std::strlen(*entry);
+			char* newEntry = allocateArray<char>(memoryResource, size + 1);
+			std::memcpy(newEntry, *entry, size + 1);
+			environment.envp[environment.envc] = newEntry;
+			++environment.envc;
+		}
+	}
+	environment.envp[environment.envc] = nullptr;
+
+	return environment;
+}
+
+void Environment::setValue(const std::string& name, const std::string& value) {
+	char* newEntry = createEntry(name.data(), name.size(), value.data(), value.size());
+
+	for(std::size_t i = 0; i<envc; ++i) {
+		if(std::strncmp(envp[i], newEntry, name.size() + 1) == 0) {
+			deallocateArray(memoryResource, envp[i], std::strlen(envp[i]) + 1);
+			envp[i] = newEntry;
+			return;
+		}
+	}
+
+	char** newEnvp = allocateArray<char*>(memoryResource, envc + 2);
+	for(std::size_t i = 0; i<envc; ++i) {
+		newEnvp[i] = envp[i];
+	}
+	newEnvp[envc] = newEntry;
+	newEnvp[envc + 1] = nullptr;
+
+	if(envp) {
+		deallocateArray(memoryResource, envp, envc + 1);
+	}
+	envp = newEnvp;
+	++envc;
+}
+
 char* const* Environment::getEnvp() const {
 	return envp;
 }
 
+char* Environment::createEntry(const char* name, std::size_t nameSize, const char* value, std::size_t valueSize) {
+	char* entry = allocateArray<char>(memoryResource, nameSize + valueSize + 2);
+	std::memcpy(entry, name, nameSize);
+	entry[nameSize] = '=';
+	std::memcpy(entry + nameSize + 1, value, valueSize);
+	entry[nameSize + valueSize + 1] = 0;
+	return entry;
+}
+
+void Environment::release() noexcept {
+    for(std::size_t i = 0; i<envc; ++i) {
+		deallocateArray(memoryResource, envp[i], std::strlen(envp[i]) + 1);
+    }
+    if(envp) {
+		deallocateArray(memoryResource, envp, envc + 1);
+    }
+	envc = 0;
+	envp = nullptr;
+}
+
 } /* namespace process */
 } /* namespace zsystem */
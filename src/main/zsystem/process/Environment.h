@@ -23,6 +23,8 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_ENVIRONMENT_H_
 #define ZSYSTEM_PROCESS_ENVIRONMENT_H_
 
+#include <zsystem/MemoryResource.h>
+
 #include <string>
 #include <vector>
 #include <utility>
@@ -35,17 +37,36 @@ public:
 	Environment();
 	Environment(const Environment&) = delete;
 	Environment(Environment&& other);
-	Environment(const std::vector<std::pair<std::string, std::string>>& values);
+
+	/* envp and its entries are allocated from memoryResource, see MemoryResource.h */
+	explicit Environment(MemoryResource* memoryResource);
+	Environment(const std::vector<std::pair<std::string, std::string>>& values, MemoryResource* memoryResource = nullptr);
 	~Environment();
 
 	Environment& operator=(const Environment&) = delete;
 	Environment& operator=(Environment&& other);
 
+	/* returns a copy of the environment of this process */
+	static Environment copyCurrent(MemoryResource* memoryResource = nullptr);
+
+	/* returns a copy of this environment, allocated from the same memory resource */
+	Environment copy() const;
+
+	/* replaces the value of an existing variable or adds a new variable */
+	void setValue(const std::string& name, const std::string& value);
+
 	char* const* getEnvp() const;
 
 private:
+	static Environment copyEntries(char* const* entries, MemoryResource* memoryResource);
+
+	/* allocates "name=value" */
+	char* createEntry(const char* name, std::size_t nameSize, const char* value, std::size_t valueSize);
+	void release() noexcept;
+
 	std::size_t envc = 0;
 	char** envp = nullptr;
+	MemoryResource* memoryResource = nullptr;
 };
 
 } /* namespace process */
@@ -23,12 +23,76 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_FEATURE_H_
 #define ZSYSTEM_PROCESS_FEATURE_H_
 
+#include <zsystem/process/FileDescriptor.h>
+
+#include <sys/types.h>
+#include <sys/resource.h>
+
+#include <chrono>
+#include <functional>
+
 namespace zsystem {
 namespace process {
 
+/* A Feature is attached to one Process::execute call. Process calls the hooks in this order:
+ * onBeforeFork, onChild (in the child), onSpawn, onIteration (for each iteration of the parent loop), onExit.
+ * onOutput is called whenever a consumer has received output.
+ * The default implementations do nothing, so a feature implements only the hooks it needs. */
 class Feature {
 public:
+	/* services of the parent loop, valid during one execution */
+	class Context {
+	public:
+		/* wakes the parent loop once, so onIteration is called even if no stream is ready.
+		 * The wakeups of all features share one timerfd of the parent loop, its resolution is 1ms. */
+		class Wakeup {
+		public:
+			/* (re-)arms the wakeup to fire after delay */
+			virtual void wakeAfter(std::chrono::milliseconds delay) = 0;
+			virtual void cancel() = 0;
+
+		protected:
+			~Wakeup() = default;
+		};
+
+		/* returns a wakeup that is not armed yet. It is valid until onExit has been called.
+		 * If onWakeup is given, it is called by the parent loop when the wakeup fires, also after the streams
+		 * have been closed until the child has terminated. It may arm the wakeup again. */
+		virtual Wakeup& addWakeup(std::function<void()> onWakeup) = 0;
+
+		Wakeup& addWakeup() {
+			return addWakeup(nullptr);
+		}
+
+		/* true if the child becomes the leader of its own process group (see Process::setGroup).
+		 * Then a feature that signals the child should signal the whole group, e.g. by Signal::sendSignal. */
+		virtual bool isGroupLeader() const noexcept = 0;
+
+	protected:
+		~Context() = default;
+	};
+
 	virtual ~Feature() = default;
+
+	/* called by the parent before fork, e.g. to allocate state shared with the child */
+	virtual void onBeforeFork(Context& /*context*/) { }
+
+	/* called by the child between fork and exec. Must be async-signal-safe: no allocation, no locks, no stdio.
+	 * Return false to abort the child with EXIT_FAILURE. */
+	virtual bool onChild() noexcept { return true; }
+
+	/* called by the parent after fork. pidHandle is the pidfd of the child or FileDescriptor::noHandle */
+	virtual void onSpawn(pid_t /*pid*/, FileDescriptor::Handle /*pidHandle*/) { }
+
+	/* called by the parent after each iteration of the loop that processes the streams */
+	virtual void onIteration() { }
+
+	/* called by the parent if a consumer has received output of the child.
+	 * Output written directly to a file (ConsumerFile) is not seen by the parent. */
+	virtual void onOutput() { }
+
+	/* called by the parent after the child has been reaped. status is the status returned by wait4 */
+	virtual void onExit(int /*status*/, const struct rusage& /*rusage*/) { }
 };
 
 } /* namespace process */
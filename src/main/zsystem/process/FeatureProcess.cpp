@@ -23,26 +23,40 @@ SOFTWARE.
 #include <zsystem/process/FeatureProcess.h>
 #include <zsystem/Process.h>
 
-#include <sys/types.h>
-#include <signal.h>
+#include <zsystem/Signal.h>
 
 namespace zsystem {
 namespace process {
 
 void FeatureProcess::stop() {
-	if(pid != Process::noHandle) {
-		::kill(pid, SIGTERM);
-	}
+	sendSignal(Signal::Type::terminate, false);
 }
 
 void FeatureProcess::kill() {
-	if(pid != Process::noHandle) {
-		::kill(pid, SIGKILL);
-	}
+	sendSignal(Signal::Type::kill, false);
 }
 
-void FeatureProcess::setProcessHandle(Process::Handle aPid) noexcept {
+void FeatureProcess::stopGroup() {
+	sendSignal(Signal::Type::terminate, true);
+}
+
+void FeatureProcess::killGroup() {
+	sendSignal(Signal::Type::kill, true);
+}
+
+void FeatureProcess::onSpawn(pid_t aPid, FileDescriptor::Handle aPidHandle) {
 	pid = aPid;
+	pidHandle = aPidHandle;
+}
+
+void FeatureProcess::onExit(int, const struct rusage&) {
+	/* pid might be used by another process now */
+	pid = Process::noHandle;
+	pidHandle = FileDescriptor::noHandle;
+}
+
+void FeatureProcess::sendSignal(Signal::Type signal, bool group) {
+	Signal::sendSignal(pid, pidHandle, group, signal);
 }
 
 } /* namespace process */
@@ -24,7 +24,9 @@ SOFTWARE.
 #define ZSYSTEM_PROCESS_FEATUREPROCESS_H_
 
 #include <zsystem/process/Feature.h>
+#include <zsystem/process/FileDescriptor.h>
 #include <zsystem/Process.h>
+#include <zsystem/Signal.h>
 
 namespace zsystem {
 namespace process {
@@ -34,10 +36,18 @@ public:
 	void stop();
 	void kill();
 
-	void setProcessHandle(Process::Handle pid) noexcept;
+	/* same as stop() and kill(), but signals the process group if the child is the leader of its own group */
+	void stopGroup();
+	void killGroup();
+
+	void onSpawn(pid_t pid, FileDescriptor::Handle pidHandle) override;
+	void onExit(int status, const struct rusage& rusage) override;
 
 private:
+	void sendSignal(Signal::Type signal, bool group);
+
 	Process::Handle pid = Process::noHandle;
+	FileDescriptor::Handle pidHandle = FileDescriptor::noHandle;
 };
 
 } /* namespace process */
@@ -0,0 +1,275 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/FeatureThrottle.h>
+#include <zsystem/Process.h>
+#include <zsystem/Signal.h>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace zsystem {
+namespace process {
+
+namespace {
+std::uint64_t getMonotonicNs() noexcept {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<std::uint64_t>(now.tv_sec) * 1000000000 + static_cast<std::uint64_t>(now.tv_nsec);
+}
+
+/* reads process group, utime + stime and cutime + cstime in clock ticks from /proc/<pid>/stat.
+ * The times of /proc/<pid>/stat cover all threads of the process. */
+bool readStat(const char* path, Process::Handle& pgrp, unsigned long long& ticks, unsigned long long& childTicks) noexcept {
+	char buffer[1024];
+
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if(fd == -1) {
+		return false;
+	}
+	ssize_t count = read(fd, buffer, sizeof(buffer) - 1);
+	close(fd);
+	if(count <= 0) {
+		return false;
+	}
+	buffer[count] = 0;
+
+	/* fields after "pid (comm)" start with field 3. pgrp is field 5, utime, stime, cutime and cstime are field 14 to 17 */
+	const char* ptr = std::strrchr(buffer, ')');
+	if(ptr == nullptr) {
+		return false;
+	}
+	for(int field = 2; field < 5 && ptr; ++field) {
+		ptr = std::strchr(ptr + 1, ' ');
+	}
+	if(ptr == nullptr) {
+		return false;
+	}
+	pgrp = static_cast<Process::Handle>(std::strtol(ptr, nullptr, 10));
+	for(int field = 5; field < 14 && ptr; ++field) {
+		ptr = std::strchr(ptr + 1, ' ');
+	}
+	if(ptr == nullptr) {
+		return false;
+	}
+
+	char* end;
+	unsigned long long utime = std::strtoull(ptr, &end, 10);
+	unsigned long long stime = std::strtoull(end, &end, 10);
+	unsigned long long cutime = std::strtoull(end, &end, 10);
+	unsigned long long cstime = std::strtoull(end, nullptr, 10);
+	ticks = utime + stime;
+	childTicks = cutime + cstime;
+	return true;
+}
+
+/* reads the CPU time of a process in ns, or of all processes of the process group if group is set.
+ * For a group the times of reaped children are added as well, so the sum does not drop if a member terminates.
+ * /proc is read by getdents64 into a buffer on the stack, because the parent loop must not allocate. */
+bool readCpuTimeNs(Process::Handle pid, bool group, std::uint64_t& cpuTimeNs) noexcept {
+	char path[sizeof("/proc//stat") + NAME_MAX];
+	Process::Handle pgrp;
+	unsigned long long ticks;
+	unsigned long long childTicks;
+	unsigned long long sum = 0;
+	bool found = false;
+
+	if(!group) {
+		std::snprintf(path, sizeof(path), "/proc/%d/stat", static_cast<int>(pid));
+		if(!readStat(path, pgrp, ticks, childTicks)) {
+			return false;
+		}
+		sum = ticks;
+		found = true;
+	}
+	else {
+		int dirFd = open("/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if(dirFd == -1) {
+			return false;
+		}
+
+		alignas(8) char buffer[8192];
+		while(true) {
+			long count = syscall(SYS_getdents64, dirFd, buffer, sizeof(buffer));
+			if(count <= 0) {
+				break;
+			}
+			for(long pos = 0; pos < count;) {
+				/* struct linux_dirent64: d_ino (8), d_off (8), d_reclen (2), d_type (1), d_name */
+				unsigned short recordLength;
+				std::memcpy(&recordLength, &buffer[pos + 16], sizeof(recordLength));
+				const char* name = &buffer[pos + 19];
+				pos += recordLength;
+
+				if(*name < '1' || *name > '9') {
+					continue;
+				}
+				std::snprintf(path, sizeof(path), "/proc/%s/stat", name);
+				if(readStat(path, pgrp, ticks, childTicks) && pgrp == pid) {
+					sum += ticks + childTicks;
+					found = true;
+				}
+			}
+		}
+		close(dirFd);
+	}
+
+	if(!found) {
+		return false;
+	}
+	cpuTimeNs = sum * 1000000000ULL / static_cast<unsigned long long>(sysconf(_SC_CLK_TCK));
+	return true;
+}
+
+}
+
+void FeatureThrottle::setCpuShare(double aCpuShare) noexcept {
+	cpuShare = aCpuShare;
+}
+
+double FeatureThrottle::getCpuShare() const noexcept {
+	return cpuShare;
+}
+
+void FeatureThrottle::setPeriod(std::chrono::milliseconds aPeriod) noexcept {
+	period = aPeriod;
+}
+
+std::chrono::milliseconds FeatureThrottle::getPeriod() const noexcept {
+	return period;
+}
+
+const FeatureThrottle::Statistics& FeatureThrottle::getStatistics() const noexcept {
+	return statistics;
+}
+
+FeatureThrottle::Statistics& FeatureThrottle::getStatistics() noexcept {
+	return statistics;
+}
+
+void FeatureThrottle::onBeforeFork(Context& context) {
+	statistics = Statistics();
+	wakeup = (cpuShare > 0.0) ? &context.addWakeup([this]() { sample(); }) : nullptr;
+	group = context.isGroupLeader();
+}
+
+void FeatureThrottle::onSpawn(pid_t aPid, FileDescriptor::Handle aPidHandle) {
+	pid = aPid;
+	pidHandle = aPidHandle;
+	if(!wakeup) {
+		return;
+	}
+
+	maxBudgetNs = cpuShare * 1000000.0 * static_cast<double>(period.count());
+	resumeBudgetNs = maxBudgetNs / 4;
+	budgetNs = maxBudgetNs;
+	lastWallNs = getMonotonicNs();
+	lastCpuNs = 0;
+	stopped = false;
+
+	/* until the first sample the child might use all CPUs */
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	cpuRate = (cpus > 0) ? static_cast<double>(cpus) : 1.0;
+	schedule();
+}
+
+void FeatureThrottle::onExit(int, const struct rusage&) {
+	wakeup = nullptr;
+
+	/* pid might be used by another process now */
+	pid = -1;
+	pidHandle = FileDescriptor::noHandle;
+}
+
+void FeatureThrottle::sample() {
+	std::uint64_t cpuNs;
+	if(!readCpuTimeNs(pid, group, cpuNs)) {
+		/* The child or group has terminated or /proc could not be read, e.g. EMFILE.
+		 * A stopped child is not left stopped, and it is tried again after a period. */
+		if(stopped) {
+			Signal::sendSignal(pid, pidHandle, group, Signal::Type::cont);
+			stopped = false;
+		}
+		wakeup->wakeAfter(period);
+		return;
+	}
+	if(cpuNs < lastCpuNs) {
+		/* a member of the group has been reaped by a process outside of the group */
+		cpuNs = lastCpuNs;
+	}
+	std::uint64_t wallNs = getMonotonicNs();
+
+	++statistics.samples;
+	statistics.cpuTime = std::chrono::nanoseconds(cpuNs);
+	if(stopped) {
+		statistics.stoppedTime += std::chrono::nanoseconds(wallNs - lastWallNs);
+	}
+
+	budgetNs += cpuShare * static_cast<double>(wallNs - lastWallNs) - static_cast<double>(cpuNs - lastCpuNs);
+	if(budgetNs > maxBudgetNs) {
+		budgetNs = maxBudgetNs;
+	}
+	if(wallNs > lastWallNs) {
+		cpuRate = static_cast<double>(cpuNs - lastCpuNs) / static_cast<double>(wallNs - lastWallNs);
+	}
+	lastWallNs = wallNs;
+	lastCpuNs = cpuNs;
+
+	if(!stopped && budgetNs < 0) {
+		Signal::sendSignal(pid, pidHandle, group, Signal::Type::stop);
+		stopped = true;
+		++statistics.stops;
+	}
+	else if(stopped && budgetNs >= resumeBudgetNs) {
+		Signal::sendSignal(pid, pidHandle, group, Signal::Type::cont);
+		stopped = false;
+	}
+
+	schedule();
+}
+
+void FeatureThrottle::schedule() {
+	double waitNs;
+	if(stopped) {
+		/* time until the budget allows to resume */
+		waitNs = (resumeBudgetNs - budgetNs) / cpuShare;
+	}
+	else {
+		/* time the child needs to use up its budget at the CPU rate of the last interval,
+		 * at least at the rate of cpuShare, so an idle child is sampled once per period */
+		waitNs = budgetNs / std::max(cpuRate, cpuShare);
+	}
+
+	wakeup->wakeAfter(std::chrono::milliseconds(static_cast<std::int64_t>(waitNs / 1000000.0 + 0.5)));
+}
+
+} /* namespace process */
+} /* namespace zsystem */
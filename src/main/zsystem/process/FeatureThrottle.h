@@ -0,0 +1,100 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_FEATURETHROTTLE_H_
+#define ZSYSTEM_PROCESS_FEATURETHROTTLE_H_
+
+#include <zsystem/process/Feature.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace zsystem {
+namespace process {
+
+/* FeatureThrottle limits the CPU usage of a child executed by Process::execute without cgroups.
+ *
+ * A wakeup of the parent loop samples the CPU time of the child, utime + stime of all its threads from /proc/<pid>/stat, and
+ * keeps a budget that grows by "cpuShare" per elapsed time and shrinks by the CPU time used. The budget is
+ * limited to cpuShare * period, so the child cannot save up more than that. If the budget is exhausted
+ * the child is stopped by SIGSTOP and continued by SIGCONT as soon as a quarter of the maximum budget is available again.
+ * While the child is under its budget it is sampled rarely, the next sample is taken when the remaining
+ * budget is used up at the CPU rate of the last interval, an idle child is sampled once per period.
+ * If /proc cannot be read, a stopped child is continued and it is sampled again after a period.
+ * If the child is the leader of its own process group (see Process::setGroup), the CPU time of all members
+ * of the group is summed up, including children they have reaped, and the whole group is stopped.
+ * Otherwise descendants of the child are neither counted nor stopped.
+ * The resolution of /proc/<pid>/stat is one clock tick, usually 10ms. */
+class FeatureThrottle : public Feature {
+public:
+	struct Statistics {
+		std::uint64_t samples = 0;
+		std::uint64_t stops = 0;
+		std::chrono::nanoseconds cpuTime = std::chrono::nanoseconds(0);
+		std::chrono::nanoseconds stoppedTime = std::chrono::nanoseconds(0);
+	};
+
+	/* share of one CPU, e.g. 0.25 for 25% */
+	void setCpuShare(double cpuShare) noexcept;
+	double getCpuShare() const noexcept;
+
+	/* default: 100ms */
+	void setPeriod(std::chrono::milliseconds period) noexcept;
+	std::chrono::milliseconds getPeriod() const noexcept;
+
+	/* statistics of the last execution */
+	const Statistics& getStatistics() const noexcept;
+	Statistics& getStatistics() noexcept;
+
+	void onBeforeFork(Context& context) override;
+	void onSpawn(pid_t pid, FileDescriptor::Handle pidHandle) override;
+	void onExit(int status, const struct rusage& rusage) override;
+
+private:
+	void sample();
+	void schedule();
+
+	double cpuShare = 1.0;
+	std::chrono::milliseconds period = std::chrono::milliseconds(100);
+	Statistics statistics;
+
+	/* state of one execution */
+	Context::Wakeup* wakeup = nullptr;
+	pid_t pid = -1;
+	FileDescriptor::Handle pidHandle = FileDescriptor::noHandle;
+	bool group = false;
+	double maxBudgetNs = 0;
+	/* a stopped child is resumed with a quarter of the maximum budget, so it is not stopped again immediately */
+	double resumeBudgetNs = 0;
+	/* CPUs used by the child during the last interval */
+	double cpuRate = 0;
+	double budgetNs = 0;
+	std::uint64_t lastWallNs = 0;
+	std::uint64_t lastCpuNs = 0;
+	bool stopped = false;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_FEATURETHROTTLE_H_ */
@@ -25,23 +25,33 @@ SOFTWARE.
 namespace zsystem {
 namespace process {
 
+namespace {
+unsigned int toMs(const struct timeval& tv) noexcept {
+	return static_cast<unsigned int>(tv.tv_sec * 1000 + tv.tv_usec / 1000);
+}
+} /* namespace {anonymous} */
+
 unsigned int FeatureTime::getRealMS() const noexcept {
-	return timeDataPtr ? timeDataPtr->realMs : timeData.realMs;
+	return timeData.realMs;
 }
 
 unsigned int FeatureTime::getUserMS() const noexcept {
-	return timeDataPtr ? timeDataPtr->userMs : timeData.userMs;
+	return timeData.userMs;
 }
 
 unsigned int FeatureTime::getSysMS() const noexcept {
-	return timeDataPtr ? timeDataPtr->sysMs : timeData.sysMs;
+	return timeData.sysMs;
+}
+
+void FeatureTime::onSpawn(pid_t, FileDescriptor::Handle) {
+	startTime = std::chrono::steady_clock::now();
+	timeData = TimeData();
 }
 
-void FeatureTime::setTimeDataPtr(TimeData* aTimeData) noexcept {
-	if(timeDataPtr && aTimeData == nullptr) {
-		timeData = *timeDataPtr;
-	}
-	timeDataPtr = aTimeData;
+void FeatureTime::onExit(int, const struct rusage& rusage) {
+	timeData.realMs = static_cast<unsigned int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+	timeData.userMs = toMs(rusage.ru_utime);
+	timeData.sysMs = toMs(rusage.ru_stime);
 }
 
 } /* namespace process */
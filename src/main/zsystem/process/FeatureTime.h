@@ -25,9 +25,14 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_FEATURETIME_H_
 #define ZSYSTEM_PROCESS_FEATURETIME_H_
 
+#include <chrono>
+
 namespace zsystem {
 namespace process {
 
+/* FeatureTime measures the real time from spawning until reaping the child and the user and system
+ * CPU time from the rusage returned by wait4. Like times() it includes the descendants of the child
+ * that have been waited for. */
 class FeatureTime : public Feature {
 public:
 	struct TimeData {
@@ -40,10 +45,11 @@ public:
 	unsigned int getUserMS() const noexcept;
 	unsigned int getSysMS() const noexcept;
 
-	void setTimeDataPtr(TimeData* timeData) noexcept;
+	void onSpawn(pid_t pid, FileDescriptor::Handle pidHandle) override;
+	void onExit(int status, const struct rusage& rusage) override;
 
 private:
-	TimeData* timeDataPtr = nullptr;
+	std::chrono::steady_clock::time_point startTime;
 	TimeData timeData;
 };
 
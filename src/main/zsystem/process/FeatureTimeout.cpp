@@ -0,0 +1,125 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/FeatureTimeout.h>
+#include <zsystem/Signal.h>
+
+namespace zsystem {
+namespace process {
+
+void FeatureTimeout::setSoftTimeout(std::chrono::milliseconds timeout) noexcept {
+	softTimeout = timeout;
+}
+
+void FeatureTimeout::setHardTimeout(std::chrono::milliseconds timeout) noexcept {
+	hardTimeout = timeout;
+}
+
+void FeatureTimeout::setIdleTimeout(std::chrono::milliseconds timeout) noexcept {
+	idleTimeout = timeout;
+}
+
+std::chrono::milliseconds FeatureTimeout::getSoftTimeout() const noexcept {
+	return softTimeout;
+}
+
+std::chrono::milliseconds FeatureTimeout::getHardTimeout() const noexcept {
+	return hardTimeout;
+}
+
+std::chrono::milliseconds FeatureTimeout::getIdleTimeout() const noexcept {
+	return idleTimeout;
+}
+
+FeatureTimeout::Reason FeatureTimeout::getReason() const noexcept {
+	return reason;
+}
+
+void FeatureTimeout::setReason(Reason aReason) noexcept {
+	reason = aReason;
+}
+
+void FeatureTimeout::onBeforeFork(Context& context) {
+	reason = Reason::none;
+	group = context.isGroupLeader();
+
+	softWakeup = softTimeout.count() > 0 ? &context.addWakeup([this]() { expired(Reason::soft); }) : nullptr;
+	hardWakeup = hardTimeout.count() > 0 ? &context.addWakeup([this]() { expired(Reason::hard); }) : nullptr;
+	idleWakeup = idleTimeout.count() > 0 ? &context.addWakeup([this]() { expired(Reason::idle); }) : nullptr;
+}
+
+void FeatureTimeout::onSpawn(pid_t aPid, FileDescriptor::Handle aPidHandle) {
+	pid = aPid;
+	pidHandle = aPidHandle;
+
+	if(softWakeup) {
+		softWakeup->wakeAfter(softTimeout);
+	}
+	if(hardWakeup) {
+		hardWakeup->wakeAfter(hardTimeout);
+	}
+	if(idleWakeup) {
+		idleWakeup->wakeAfter(idleTimeout);
+		idleArmed = true;
+	}
+}
+
+void FeatureTimeout::onOutput() {
+	/* moving the wakeup is O(1) and needs no system call */
+	if(idleArmed) {
+		idleWakeup->wakeAfter(idleTimeout);
+	}
+}
+
+void FeatureTimeout::onExit(int, const struct rusage&) {
+	softWakeup = nullptr;
+	hardWakeup = nullptr;
+	idleWakeup = nullptr;
+	idleArmed = false;
+
+	/* pid might be used by another process now */
+	pid = -1;
+	pidHandle = FileDescriptor::noHandle;
+}
+
+void FeatureTimeout::expired(Reason aReason) {
+	if(aReason == Reason::idle) {
+		idleArmed = false;
+	}
+
+	/* a hard timeout after a soft or idle timeout has killed the child, so it is the reason */
+	if(reason == Reason::none || aReason == Reason::hard) {
+		reason = aReason;
+	}
+	if(aReason == Reason::hard) {
+		Signal::sendSignal(pid, pidHandle, group, Signal::Type::kill);
+	}
+	else {
+		Signal::sendSignal(pid, pidHandle, group, Signal::Type::terminate);
+		/* child might be stopped by FeatureThrottle */
+		Signal::sendSignal(pid, pidHandle, group, Signal::Type::cont);
+	}
+}
+
+} /* namespace process */
+} /* namespace zsystem */
@@ -0,0 +1,91 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_FEATURETIMEOUT_H_
+#define ZSYSTEM_PROCESS_FEATURETIMEOUT_H_
+
+#include <zsystem/process/Feature.h>
+
+#include <chrono>
+
+namespace zsystem {
+namespace process {
+
+/* FeatureTimeout bounds the runtime of a child executed by Process::execute.
+ * - soft timeout: SIGTERM after this time since start
+ * - hard timeout: SIGKILL after this time since start
+ * - idle timeout: SIGTERM if no output has been received by a consumer for this time.
+ *   Output written directly to a file (ConsumerFile) is not seen by the parent.
+ * A timeout of 0 is disabled.
+ *
+ * The timeouts are wakeups of the parent loop of Process::execute, there is no watchdog thread.
+ * If the child is the leader of its own process group (see Process::setGroup), the whole group is signaled. */
+class FeatureTimeout : public Feature {
+public:
+	enum class Reason {
+		none,
+		soft,
+		hard,
+		idle
+	};
+
+	void setSoftTimeout(std::chrono::milliseconds timeout) noexcept;
+	void setHardTimeout(std::chrono::milliseconds timeout) noexcept;
+	void setIdleTimeout(std::chrono::milliseconds timeout) noexcept;
+
+	std::chrono::milliseconds getSoftTimeout() const noexcept;
+	std::chrono::milliseconds getHardTimeout() const noexcept;
+	std::chrono::milliseconds getIdleTimeout() const noexcept;
+
+	/* returns the first timeout that has expired during the last execution,
+	 * or hard if the hard timeout has killed the child after a soft or idle timeout */
+	Reason getReason() const noexcept;
+	void setReason(Reason reason) noexcept;
+
+	void onBeforeFork(Context& context) override;
+	void onSpawn(pid_t pid, FileDescriptor::Handle pidHandle) override;
+	void onOutput() override;
+	void onExit(int status, const struct rusage& rusage) override;
+
+private:
+	void expired(Reason reason);
+
+	std::chrono::milliseconds softTimeout = std::chrono::milliseconds(0);
+	std::chrono::milliseconds hardTimeout = std::chrono::milliseconds(0);
+	std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(0);
+	Reason reason = Reason::none;
+
+	/* state of one execution */
+	Context::Wakeup* softWakeup = nullptr;
+	Context::Wakeup* hardWakeup = nullptr;
+	Context::Wakeup* idleWakeup = nullptr;
+	bool idleArmed = false;
+	pid_t pid = -1;
+	FileDescriptor::Handle pidHandle = FileDescriptor::noHandle;
+	bool group = false;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_FEATURETIMEOUT_H_ */
@@ -25,10 +25,18 @@ SOFTWARE.
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/ioctl.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
-
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <cstdlib>
 #include <cstring>
 #include <stdexcept>
 #include <iostream>
@@ -42,11 +50,14 @@ const FileDescriptor::Handle FileDescriptor::stdOutHandle = STDOUT_FILENO; // 1
 const FileDescriptor::Handle FileDescriptor::stdErrHandle = STDERR_FILENO; // 2
 
 const std::size_t FileDescriptor::npos = static_cast<std::size_t>(-1);
+const std::size_t FileDescriptor::wouldBlock = static_cast<std::size_t>(-2);
+const std::size_t FileDescriptor::notSupported = static_cast<std::size_t>(-3);
 
 std::pair<FileDescriptor, FileDescriptor> FileDescriptor::openUnidirectional() {
 	int pipeFd[2];
+	/* O_CLOEXEC: children of other threads must not inherit this pipe. Process::execute uses dup2 to pass it to its own child. */
 	//if(pipe2(pipeFd, O_NONBLOCK) == -1) {
-	if(pipe2(pipeFd, 0) == -1) {
+	if(pipe2(pipeFd, O_CLOEXEC) == -1) {
 		throw std::runtime_error(std::string("FileDescriptor::createPipe() failed: ") + std::strerror(errno));
 	}
 
@@ -55,7 +66,7 @@ std::pair<FileDescriptor, FileDescriptor> FileDescriptor::openUnidirectional() {
 
 std::pair<FileDescriptor, FileDescriptor> FileDescriptor::openBidirectional() {
 	int socketFd[2];
-	if(socketpair(AF_UNIX, SOCK_STREAM, 0, socketFd) == -1) {
+	if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, socketFd) == -1) {
 		throw std::runtime_error(std::string("FileDescriptor::createPipe() failed: ") + std::strerror(errno));
 	}
 
@@ -64,7 +75,7 @@ std::pair<FileDescriptor, FileDescriptor> FileDescriptor::openBidirectional() {
 
 FileDescriptor FileDescriptor::openFile(const std::string& filename, bool isRead, bool isWrite, bool doOverwrite) {
 	if(isRead || isWrite) {
-		int flags = O_NOCTTY;
+		int flags = O_NOCTTY | O_CLOEXEC;
 
 		if(!isWrite) {
 			flags |= O_RDONLY;
@@ -102,6 +113,95 @@ FileDescriptor FileDescriptor::openFile(const std::string& filename, bool isRead
 	return FileDescriptor();
 }
 
+FileDescriptor FileDescriptor::openUnixSocketListener(const std::string& path, int backlog) {
+	struct sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if(path.size() >= sizeof(address.sun_path)) {
+		throw std::runtime_error("FileDescriptor::openUnixSocketListener(\"" + path + "\", ...) failed: path too long");
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	FileDescriptor fileDescriptor(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+	if(!fileDescriptor) {
+		throw std::runtime_error("FileDescriptor::openUnixSocketListener(\"" + path + "\", ...) failed: " + std::strerror(errno));
+	}
+
+	unlink(path.c_str());
+	if(bind(fileDescriptor.getHandle(), reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1
+	|| listen(fileDescriptor.getHandle(), backlog) == -1) {
+		throw std::runtime_error("FileDescriptor::openUnixSocketListener(\"" + path + "\", ...) failed: " + std::strerror(errno));
+	}
+
+	return fileDescriptor;
+}
+
+FileDescriptor FileDescriptor::openTcpSocketListener(const std::string& address, std::uint16_t port, int backlog, bool reusePort) {
+	struct sockaddr_in address4;
+	struct sockaddr_in6 address6;
+	struct sockaddr* socketAddress;
+	socklen_t socketAddressLength;
+
+	std::memset(&address4, 0, sizeof(address4));
+	std::memset(&address6, 0, sizeof(address6));
+
+	if(inet_pton(AF_INET, address.c_str(), &address4.sin_addr) == 1) {
+		address4.sin_family = AF_INET;
+		address4.sin_port = htons(port);
+		socketAddress = reinterpret_cast<struct sockaddr*>(&address4);
+		socketAddressLength = sizeof(address4);
+	}
+	else if(inet_pton(AF_INET6, address.c_str(), &address6.sin6_addr) == 1) {
+		address6.sin6_family = AF_INET6;
+		address6.sin6_port = htons(port);
+		socketAddress = reinterpret_cast<struct sockaddr*>(&address6);
+		socketAddressLength = sizeof(address6);
+	}
+	else {
+		throw std::runtime_error("FileDescriptor::openTcpSocketListener(\"" + address + "\", ...) failed: invalid address");
+	}
+
+	FileDescriptor fileDescriptor(socket(socketAddress->sa_family, SOCK_STREAM | SOCK_CLOEXEC, 0));
+	if(!fileDescriptor) {
+		throw std::runtime_error("FileDescriptor::openTcpSocketListener(\"" + address + "\", ...) failed: " + std::strerror(errno));
+	}
+
+	int on = 1;
+	setsockopt(fileDescriptor.getHandle(), SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	if(reusePort && setsockopt(fileDescriptor.getHandle(), SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) == -1) {
+		throw std::runtime_error("FileDescriptor::openTcpSocketListener(\"" + address + "\", ...) failed: SO_REUSEPORT: " + std::strerror(errno));
+	}
+
+	if(bind(fileDescriptor.getHandle(), socketAddress, socketAddressLength) == -1
+	|| listen(fileDescriptor.getHandle(), backlog) == -1) {
+		throw std::runtime_error("FileDescriptor::openTcpSocketListener(\"" + address + "\", " + std::to_string(port) + ", ...) failed: " + std::strerror(errno));
+	}
+
+	return fileDescriptor;
+}
+
+FileDescriptor FileDescriptor::openTimer() {
+	FileDescriptor fileDescriptor(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK));
+	if(!fileDescriptor) {
+		throw std::runtime_error(std::string("FileDescriptor::openTimer() failed: ") + std::strerror(errno));
+	}
+
+	return fileDescriptor;
+}
+
+FileDescriptor FileDescriptor::openProcess(int pid) {
+#ifdef SYS_pidfd_open
+	/* pidfds are always close-on-exec */
+	FileDescriptor fileDescriptor(static_cast<int>(syscall(SYS_pidfd_open, pid, 0)));
+	if(!fileDescriptor && errno != ENOSYS && errno != ESRCH && errno != EPERM) {
+		throw std::runtime_error(std::string("FileDescriptor::openProcess() failed: ") + std::strerror(errno));
+	}
+	return fileDescriptor;
+#else
+	return FileDescriptor();
+#endif
+}
+
 FileDescriptor::FileDescriptor(FileDescriptor&& other)
 : fd(other.fd)
 {
@@ -144,6 +244,23 @@ FileDescriptor::Handle FileDescriptor::release() noexcept {
 	return rv;
 }
 
+FileDescriptor FileDescriptor::duplicate() const {
+	if(fd == noHandle) {
+		return FileDescriptor();
+	}
+
+	while(true) {
+		int newFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+		if(newFd != -1) {
+			return FileDescriptor(newFd);
+		}
+		else if(errno == EINTR) {
+			continue;
+		}
+		throw std::runtime_error(std::string("FileDescriptor::duplicate() failed: ") + std::strerror(errno));
+	}
+}
+
 std::size_t FileDescriptor::read(void* data, std::size_t size) {
 	if(fd == noHandle) {
 		return npos;
@@ -156,7 +273,10 @@ std::size_t FileDescriptor::read(void* data, std::size_t size) {
 			break;
 		}
 	}
-	return count == -1 ? npos : count;
+	if(count == -1) {
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? wouldBlock : npos;
+	}
+	return static_cast<std::size_t>(count);
 }
 
 std::size_t FileDescriptor::write(const void* data, std::size_t size) {
@@ -171,7 +291,136 @@ std::size_t FileDescriptor::write(const void* data, std::size_t size) {
 			break;
 		}
 	}
-	return count == -1 ? npos : count;
+	if(count == -1) {
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? wouldBlock : npos;
+	}
+	return static_cast<std::size_t>(count);
+}
+
+std::size_t FileDescriptor::readv(const struct iovec* iov, int count) {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	ssize_t rc;
+	while(true) {
+		rc = ::readv(fd, iov, count);
+		if(rc != -1 || errno != EINTR) {
+			break;
+		}
+	}
+	if(rc == -1) {
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? wouldBlock : npos;
+	}
+	return static_cast<std::size_t>(rc);
+}
+
+std::size_t FileDescriptor::writev(const struct iovec* iov, int count) {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	ssize_t rc;
+	while(true) {
+		rc = ::writev(fd, iov, count);
+		if(rc != -1 || errno != EINTR) {
+			break;
+		}
+	}
+	if(rc == -1) {
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? wouldBlock : npos;
+	}
+	return static_cast<std::size_t>(rc);
+}
+
+std::size_t FileDescriptor::pread(void* data, std::size_t size, std::uint64_t offset) {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	ssize_t count;
+	while(true) {
+		count = ::pread(fd, data, size, static_cast<off_t>(offset));
+		if(count != -1 || errno != EINTR) {
+			break;
+		}
+	}
+	if(count == -1) {
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? wouldBlock : npos;
+	}
+	return static_cast<std::size_t>(count);
+}
+
+std::size_t FileDescriptor::pwrite(const void* data, std::size_t size, std::uint64_t offset) {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	ssize_t count;
+	while(true) {
+		count = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+		if(count != -1 || errno != EINTR) {
+			break;
+		}
+	}
+	if(count == -1) {
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? wouldBlock : npos;
+	}
+	return static_cast<std::size_t>(count);
+}
+
+std::size_t FileDescriptor::splice(FileDescriptor& fileDescriptor, std::size_t size) {
+	if(fd == noHandle || fileDescriptor.fd == noHandle) {
+		return npos;
+	}
+
+	ssize_t count;
+	while(true) {
+		count = ::splice(fd, nullptr, fileDescriptor.fd, nullptr, size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+		if(count != -1 || errno != EINTR) {
+			break;
+		}
+	}
+	if(count == -1) {
+		if(errno == EAGAIN || errno == EWOULDBLOCK) {
+			return wouldBlock;
+		}
+		/* EINVAL: no pipe, unsupported file system or target opened with O_APPEND */
+		if(errno == EINVAL || errno == ENOSYS) {
+			return notSupported;
+		}
+		return npos;
+	}
+	return static_cast<std::size_t>(count);
+}
+
+std::size_t FileDescriptor::vmsplice(const void* data, std::size_t size) {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	struct iovec iov;
+	iov.iov_base = const_cast<void*>(data);
+	iov.iov_len = size;
+
+	ssize_t count;
+	while(true) {
+		count = ::vmsplice(fd, &iov, 1, SPLICE_F_NONBLOCK);
+		if(count != -1 || errno != EINTR) {
+			break;
+		}
+	}
+	if(count == -1) {
+		if(errno == EAGAIN || errno == EWOULDBLOCK) {
+			return wouldBlock;
+		}
+		/* EBADF: not a pipe, e.g. a socketpair */
+		if(errno == EBADF || errno == EINVAL || errno == ENOSYS) {
+			return notSupported;
+		}
+		return npos;
+	}
+	return static_cast<std::size_t>(count);
 }
 
 std::size_t FileDescriptor::getFileSize() const {
@@ -185,6 +434,14 @@ std::size_t FileDescriptor::getFileSize() const {
 	return process::FileDescriptor::npos;
 }
 
+std::size_t FileDescriptor::getReadableSize() const {
+	int size = 0;
+	if(fd == noHandle || ioctl(fd, FIONREAD, &size) == -1) {
+		return npos;
+	}
+	return static_cast<std::size_t>(size);
+}
+
 void FileDescriptor::close() {
 	if(fd != noHandle) {
 		while(::close(fd) == EINTR) { }
@@ -227,5 +484,62 @@ bool FileDescriptor::setBlocking(bool b) {
 	return true;
 }
 
+std::size_t FileDescriptor::getPipeMaxSize() {
+	/* default of the kernel if /proc is not available */
+	std::size_t pipeMaxSize = 1024 * 1024;
+
+	int procFd = ::open("/proc/sys/fs/pipe-max-size", O_RDONLY | O_CLOEXEC);
+	if(procFd != -1) {
+		char buffer[32];
+		ssize_t count = ::read(procFd, buffer, sizeof(buffer) - 1);
+		if(count > 0) {
+			buffer[count] = 0;
+			pipeMaxSize = std::strtoul(buffer, nullptr, 10);
+		}
+		::close(procFd);
+	}
+
+	return pipeMaxSize;
+}
+
+std::size_t FileDescriptor::setPipeSize(std::size_t size) {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	std::size_t pipeMaxSize = getPipeMaxSize();
+	if(size > pipeMaxSize) {
+		size = pipeMaxSize;
+	}
+
+	int rc = fcntl(fd, F_SETPIPE_SZ, static_cast<int>(size));
+	if(rc == -1) {
+		return npos;
+	}
+	return static_cast<std::size_t>(rc);
+}
+
+std::size_t FileDescriptor::getPipeSize() const {
+	if(fd == noHandle) {
+		return npos;
+	}
+
+	int rc = fcntl(fd, F_GETPIPE_SZ);
+	if(rc == -1) {
+		return npos;
+	}
+	return static_cast<std::size_t>(rc);
+}
+
+bool FileDescriptor::setSocketBufferSize(std::size_t size) {
+	if(fd == noHandle) {
+		return false;
+	}
+
+	int value = static_cast<int>(size);
+	return setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &value, sizeof(value)) == 0
+			&& setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &value, sizeof(value)) == 0;
+}
+
 } /* namespace process */
 } /* namespace zsystem */
@@ -23,11 +23,14 @@ SOFTWARE.
 #ifndef ZSYSTEM_PROCESS_FILEDESCRIPTOR_H_
 #define ZSYSTEM_PROCESS_FILEDESCRIPTOR_H_
 
+#include <cstdint>
 #include <utility>
 #include <string>
 
 //#include <unistd.h>
 
+struct iovec;
+
 namespace zsystem {
 namespace process {
 
@@ -42,10 +45,30 @@ public:
 
     static const std::size_t npos;
 
+    /* returned by read() and write() if the handle is non-blocking and no data could be transferred now */
+    static const std::size_t wouldBlock;
+
+    /* returned by splice() and vmsplice() if the kernel cannot splice between both handles, e.g. none of them is a pipe */
+    static const std::size_t notSupported;
+
 	static std::pair<FileDescriptor, FileDescriptor> openUnidirectional();
 	static std::pair<FileDescriptor, FileDescriptor> openBidirectional();
 	static FileDescriptor openFile(const std::string& filename, bool isRead, bool isWrite, bool doOverwrite);
 
+	/* creates a listening UNIX domain stream socket. An existing socket file is removed before. */
+	static FileDescriptor openUnixSocketListener(const std::string& path, int backlog);
+
+	/* creates a listening TCP socket for a numeric IPv4 or IPv6 address.
+	 * Use reusePort to bind multiple sockets to the same port. The kernel spreads incoming connections over them. */
+	static FileDescriptor openTcpSocketListener(const std::string& address, std::uint16_t port, int backlog, bool reusePort);
+
+	/* creates a non-blocking timerfd on CLOCK_MONOTONIC */
+	static FileDescriptor openTimer();
+
+	/* creates a pidfd that becomes readable if the process has terminated.
+	 * Returns an empty FileDescriptor if pidfds are not supported or the process does not exist anymore. */
+	static FileDescriptor openProcess(int pid);
+
 	FileDescriptor() = default;
 	FileDescriptor(const FileDescriptor&) = delete;
 	FileDescriptor(FileDescriptor&& other);
@@ -59,15 +82,63 @@ public:
 	Handle getHandle() const noexcept;
 	Handle release() noexcept;
 
+	/* returns a new FileDescriptor referring to the same open file, e.g. to pass it to a child multiple times */
+	FileDescriptor duplicate() const;
+
+	/* return: number of bytes read, 0 at end of file,
+	 *         wouldBlock if the handle is non-blocking and there is nothing to read now,
+	 *         npos on error */
 	std::size_t read(void* data, std::size_t size);
+
+	/* return: number of bytes written, maybe less than size,
+	 *         wouldBlock if the handle is non-blocking and nothing can be written now,
+	 *         npos on error, e.g. if the reader has closed the pipe */
 	std::size_t write(const void* data, std::size_t size);
+
+	/* scatter/gather versions of read() and write() with the same return values.
+	 * count is limited to IOV_MAX by the kernel. */
+	std::size_t readv(const struct iovec* iov, int count);
+	std::size_t writev(const struct iovec* iov, int count);
+
+	/* read() and write() at offset, without moving the file position */
+	std::size_t pread(void* data, std::size_t size, std::uint64_t offset);
+	std::size_t pwrite(const void* data, std::size_t size, std::uint64_t offset);
+	/* moves up to size bytes from this handle to fileDescriptor by splice(2), without copying them to user space.
+	 * One of both handles must be a pipe. Non-blocking for the pipe, even if it is in blocking mode.
+	 * return: number of bytes moved, 0 at end of file,
+	 *         wouldBlock if the pipe is empty or full or if the other handle is non-blocking and not ready,
+	 *         notSupported if splice is not possible for these handles, nothing has been moved then,
+	 *         npos on error */
+	std::size_t splice(FileDescriptor& fileDescriptor, std::size_t size);
+
+	/* maps the pages of data into this pipe by vmsplice(2) instead of copying them. Non-blocking like splice().
+	 * The pipe refers to the memory of the caller afterwards, so data must stay valid and unchanged
+	 * until the reader has read it.
+	 * return: same as write(), notSupported if this handle is not a pipe */
+	std::size_t vmsplice(const void* data, std::size_t size);
+
 	std::size_t getFileSize() const;
 
+	/* returns the number of bytes that can be read now (FIONREAD) of a pipe or socket, or npos on error */
+	std::size_t getReadableSize() const;
+
 	void close();
 
 	/* return true on success, false on error */
 	bool setBlocking(bool b);
 
+	/* returns the largest pipe capacity an unprivileged process can set (/proc/sys/fs/pipe-max-size) */
+	static std::size_t getPipeMaxSize();
+
+	/* sets the capacity of the pipe by F_SETPIPE_SZ. size is limited to getPipeMaxSize().
+	 * return: the capacity set by the kernel, it might be larger than size, or npos on error */
+	std::size_t setPipeSize(std::size_t size);
+	std::size_t getPipeSize() const;
+
+	/* sets SO_SNDBUF and SO_RCVBUF of a socket. The kernel limits them to net.core.wmem_max and rmem_max.
+	 * return true on success, false on error */
+	bool setSocketBufferSize(std::size_t size);
+
 private:
 	FileDescriptor(Handle fd);
 	int fd = noHandle;
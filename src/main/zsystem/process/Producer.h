@@ -39,7 +39,9 @@ public:
 	 *
 	 *         Number of characters written to fileDescriptor
 	 *           if there are data available to write to fileDescripor
-	 *           (produced now or queued from previous call). */
+	 *           (produced now or queued from previous call).
+	 *           It is 0 if fileDescriptor is non-blocking and full, then the remaining
+	 *           data must be kept and written by the next call. */
 	virtual std::size_t produce(FileDescriptor& fileDescriptor) = 0;
 };
 
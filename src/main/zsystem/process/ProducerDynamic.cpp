@@ -26,8 +26,7 @@ namespace zsystem {
 namespace process {
 
 ProducerDynamic::ProducerDynamic(std::function<std::size_t(char*, std::size_t)> aGetDataFunction)
-: getDataFunction(aGetDataFunction),
-  bufferRead(buffer)
+: getDataFunction(aGetDataFunction)
 { }
 
 ProducerDynamic::ProducerDynamic(std::string aContent)
@@ -39,8 +38,12 @@ ProducerDynamic::ProducerDynamic(std::string aContent)
 std::size_t ProducerDynamic::produce(process::FileDescriptor& fileDescriptor) {
 	if(currentPos >= currentSize) {
 		if(getDataFunction) {
+			if(!buffer) {
+				buffer = BufferPool::getDefault(chunkSize.get()).acquire();
+			}
+			bufferRead = buffer.getData();
 			currentPos = 0;
-			currentSize = getDataFunction(buffer, sizeof(buffer));
+			currentSize = getDataFunction(buffer.getData(), chunkSize.get());
 
 			if(currentSize == 0) {
 				currentSize = FileDescriptor::npos;
@@ -52,12 +55,25 @@ std::size_t ProducerDynamic::produce(process::FileDescriptor& fileDescriptor) {
 	}
 
 	if(currentSize == FileDescriptor::npos) {
+		buffer.release();
 		return FileDescriptor::npos;
 	}
 
 	std::size_t count = fileDescriptor.write(&bufferRead[currentPos], currentSize - currentPos);
-	if(count != process::FileDescriptor::npos) {
-		currentPos += count;
+	if(count == process::FileDescriptor::wouldBlock) {
+		return 0;
+	}
+	if(count == process::FileDescriptor::npos) {
+		currentSize = FileDescriptor::npos;
+		buffer.release();
+		return FileDescriptor::npos;
+	}
+	currentPos += count;
+	chunkSize.update(count);
+
+	if(currentPos >= currentSize) {
+		/* everything written, give the buffer back until the next call */
+		buffer.release();
 	}
 
 	return count;
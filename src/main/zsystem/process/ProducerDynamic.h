@@ -24,6 +24,7 @@ SOFTWARE.
 #define ZSYSTEM_PROCESS_PRODUCERDYNAMIC_H_
 
 #include <zsystem/process/Producer.h>
+#include <zsystem/process/BufferPool.h>
 #include <zsystem/process/FileDescriptor.h>
 
 #include <string>
@@ -34,6 +35,8 @@ namespace process {
 
 class ProducerDynamic : public Producer {
 public:
+	/* getDataFunction fills a pooled buffer. That is held only while its data are written.
+	 * Its size grows from BufferPool::minBufferSize while the pipe takes whole buffers, see ChunkSize. */
 	ProducerDynamic(std::function<std::size_t(char*, std::size_t)> getDataFunction);
 	ProducerDynamic(std::string content);
 
@@ -43,8 +46,9 @@ private:
 	std::function<std::size_t(char*, std::size_t)> getDataFunction;
 	std::string data;
 
-	char buffer[4096];
-	const char *bufferRead;
+	BufferPool::Buffer buffer;
+	ChunkSize chunkSize;
+	const char *bufferRead = nullptr;
 	std::size_t currentPos = 0;
 	std::size_t currentSize = 0;
 };
@@ -22,31 +22,187 @@ SOFTWARE.
 
 #include <zsystem/process/ProducerFile.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
 namespace zsystem {
 namespace process {
 
+constexpr std::size_t ProducerFile::mapWindowSize;
+
 ProducerFile::ProducerFile(FileDescriptor aFileDescriptor)
 : fileDescriptor(std::move(aFileDescriptor))
 { }
 
+ProducerFile::ProducerFile(ProducerFile&& other)
+: fileDescriptor(std::move(other.fileDescriptor)),
+  buffer(std::move(other.buffer)),
+  chunkSize(other.chunkSize),
+  currentPos(other.currentPos),
+  currentSize(other.currentSize),
+  spliceSupported(other.spliceSupported),
+  adviceApplied(other.adviceApplied),
+  mapSupported(other.mapSupported),
+  mapData(other.mapData),
+  mapSize(other.mapSize),
+  mapPos(other.mapPos),
+  mapOffset(other.mapOffset),
+  mapEnd(other.mapEnd)
+{
+	other.mapData = nullptr;
+	other.mapSize = 0;
+}
+
+ProducerFile::~ProducerFile() {
+	unmap();
+}
+
 std::size_t ProducerFile::produce(FileDescriptor& fileDescriptor) {
+	if(currentSize == process::FileDescriptor::npos) {
+		return process::FileDescriptor::npos;
+	}
+
+	if(!adviceApplied) {
+		/* fails with ESPIPE for pipes and sockets, that is fine */
+		posix_fadvise(getFileDescriptor().getHandle(), 0, 0, POSIX_FADV_SEQUENTIAL);
+		adviceApplied = true;
+	}
+
+	/* no data left in the buffer from a previous read, so data can be moved directly */
+	if(spliceSupported && currentPos >= currentSize) {
+		std::size_t count = getFileDescriptor().splice(fileDescriptor, BufferPool::maxBufferSize);
+		if(count == process::FileDescriptor::wouldBlock) {
+			return 0;
+		}
+		if(count == 0 || count == process::FileDescriptor::npos) {
+			currentPos = 0;
+			currentSize = process::FileDescriptor::npos;
+			return process::FileDescriptor::npos;
+		}
+		if(count != process::FileDescriptor::notSupported) {
+			return count;
+		}
+		spliceSupported = false;
+	}
+
+	if(mapSupported && currentPos >= currentSize) {
+		std::size_t count = produceMapped(fileDescriptor);
+		if(count != process::FileDescriptor::notSupported) {
+			return count;
+		}
+		mapSupported = false;
+	}
+
 	if(currentPos >= currentSize) {
+		if(!buffer) {
+			buffer = BufferPool::getDefault(chunkSize.get()).acquire();
+		}
+		std::size_t count = getFileDescriptor().read(buffer.getData(), chunkSize.get());
+		if(count == process::FileDescriptor::wouldBlock) {
+			/* source is a non-blocking pipe or socket without data yet */
+			buffer.release();
+			return 0;
+		}
 		currentPos = 0;
-		currentSize = getFileDescriptor().read(buffer, sizeof(buffer));
+		currentSize = count;
 	}
 
 	if(currentSize == 0 || currentSize == process::FileDescriptor::npos) {
+		currentPos = 0;
+		currentSize = process::FileDescriptor::npos;
+		buffer.release();
 		return process::FileDescriptor::npos;
 	}
 
-	std::size_t count = fileDescriptor.write(&buffer[currentPos], currentSize - currentPos);
-	if(count != process::FileDescriptor::npos) {
-		currentPos += count;
+	std::size_t count = fileDescriptor.write(&buffer.getData()[currentPos], currentSize - currentPos);
+	if(count == process::FileDescriptor::wouldBlock) {
+		return 0;
+	}
+	if(count == process::FileDescriptor::npos) {
+		currentPos = 0;
+		currentSize = process::FileDescriptor::npos;
+		buffer.release();
+		return process::FileDescriptor::npos;
+	}
+	currentPos += count;
+	chunkSize.update(count);
+
+	if(currentPos >= currentSize) {
+		/* everything written, give the buffer back until the next call */
+		buffer.release();
+	}
+
+	return count;
+}
+
+std::size_t ProducerFile::produceMapped(FileDescriptor& fileDescriptor) {
+	if(mapData == nullptr) {
+		if(mapEnd == 0) {
+			/* first call: map only regular files with data, getFileSize() is 0 for pipes and most /proc files */
+			std::size_t fileSize = getFileSize();
+			off_t position = lseek(getFileDescriptor().getHandle(), 0, SEEK_CUR);
+			if(fileSize == process::FileDescriptor::npos || position == -1 || static_cast<std::size_t>(position) >= fileSize) {
+				return process::FileDescriptor::notSupported;
+			}
+
+			/* offset of mmap must be a multiple of the page size */
+			std::uint64_t pageSize = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+			mapOffset = static_cast<std::uint64_t>(position) / pageSize * pageSize;
+			mapPos = static_cast<std::size_t>(static_cast<std::uint64_t>(position) - mapOffset);
+			mapEnd = fileSize;
+		}
+
+		if(mapOffset >= mapEnd) {
+			/* everything written. Continue with read, the file might have grown */
+			lseek(getFileDescriptor().getHandle(), static_cast<off_t>(mapEnd), SEEK_SET);
+			return process::FileDescriptor::notSupported;
+		}
+
+		std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(mapWindowSize, mapEnd - mapOffset));
+		void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, getFileDescriptor().getHandle(), static_cast<off_t>(mapOffset));
+		if(data == MAP_FAILED) {
+			/* continue with read where the mapping has stopped */
+			lseek(getFileDescriptor().getHandle(), static_cast<off_t>(mapOffset + mapPos), SEEK_SET);
+			return process::FileDescriptor::notSupported;
+		}
+		madvise(data, size, MADV_SEQUENTIAL);
+		mapData = static_cast<char*>(data);
+		mapSize = size;
+	}
+
+	std::size_t count = fileDescriptor.write(&mapData[mapPos], mapSize - mapPos);
+	if(count == process::FileDescriptor::wouldBlock) {
+		return 0;
+	}
+	if(count == process::FileDescriptor::npos) {
+		unmap();
+		currentPos = 0;
+		currentSize = process::FileDescriptor::npos;
+		return process::FileDescriptor::npos;
+	}
+	mapPos += count;
+
+	if(mapPos >= mapSize) {
+		/* window written, the next call maps the next one */
+		mapOffset += mapSize;
+		mapPos = 0;
+		unmap();
 	}
 
 	return count;
 }
 
+void ProducerFile::unmap() {
+	if(mapData) {
+		munmap(mapData, mapSize);
+		mapData = nullptr;
+		mapSize = 0;
+	}
+}
+
 std::size_t ProducerFile::getFileSize() const {
 	return fileDescriptor.getFileSize();
 }
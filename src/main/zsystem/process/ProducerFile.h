@@ -24,16 +24,30 @@ SOFTWARE.
 #define ZSYSTEM_PROCESS_PRODUCERFILE_H_
 
 #include <zsystem/process/Producer.h>
+#include <zsystem/process/BufferPool.h>
 #include <zsystem/process/FileDescriptor.h>
 
+#include <cstdint>
 #include <string>
 
 namespace zsystem {
 namespace process {
 
+/* ProducerFile moves data from the file to a pipe by splice(2), without copying it to user space.
+ * If splice is not possible, e.g. data goes to a socket, a regular file is mapped into memory in windows
+ * of mapWindowSize bytes and written from there. Otherwise it falls back to read and write.
+ * The kernel is advised to read ahead sequentially.
+ * The file must not be truncated while it is mapped, reading the mapping raises SIGBUS then. */
 class ProducerFile : public Producer {
 public:
+	static constexpr std::size_t mapWindowSize = 64 * 1024 * 1024;
+
 	ProducerFile(FileDescriptor fileDescriptor);
+	ProducerFile(const ProducerFile&) = delete;
+	ProducerFile(ProducerFile&& other);
+	~ProducerFile();
+
+	ProducerFile& operator=(const ProducerFile&) = delete;
 
 	/* return: FileDescriptor::npos
 	 *           if there is no more data to produce (IMPORTANT)
@@ -49,11 +63,26 @@ public:
 	FileDescriptor&& getFileDescriptor() &&;
 
 private:
+	/* return: same as produce(), FileDescriptor::notSupported if the file cannot be mapped */
+	std::size_t produceMapped(FileDescriptor& fileDescriptor);
+	void unmap();
+
 	FileDescriptor fileDescriptor;
 
-	char buffer[4096];
+	BufferPool::Buffer buffer;
+	ChunkSize chunkSize;
 	std::size_t currentPos = 0;
 	std::size_t currentSize = 0;
+	bool spliceSupported = true;
+	bool adviceApplied = false;
+
+	bool mapSupported = true;
+	char* mapData = nullptr;
+	std::size_t mapSize = 0;
+	std::size_t mapPos = 0;
+	/* file offsets of mapData and of the end of the file */
+	std::uint64_t mapOffset = 0;
+	std::uint64_t mapEnd = 0;
 };
 
 } /* namespace process */
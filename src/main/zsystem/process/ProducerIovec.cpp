@@ -0,0 +1,98 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/ProducerIovec.h>
+
+#include <limits.h>
+
+namespace zsystem {
+namespace process {
+
+void ProducerIovec::add(const char* data, std::size_t aSize) {
+	if(aSize == 0) {
+		return;
+	}
+
+	struct iovec buffer;
+	buffer.iov_base = const_cast<char*>(data);
+	buffer.iov_len = aSize;
+	buffers.push_back(buffer);
+	size += aSize;
+}
+
+void ProducerIovec::add(const std::string& str) {
+	add(str.data(), str.size());
+}
+
+std::size_t ProducerIovec::produce(FileDescriptor& fileDescriptor) {
+	if(currentIndex >= buffers.size()) {
+		return FileDescriptor::npos;
+	}
+
+	std::size_t count = buffers.size() - currentIndex;
+	if(count > IOV_MAX) {
+		count = IOV_MAX;
+	}
+
+	/* skip the part of the first buffer that is written already, the buffer is restored afterwards */
+	struct iovec& first = buffers[currentIndex];
+	struct iovec saved = first;
+	first.iov_base = static_cast<char*>(first.iov_base) + currentOffset;
+	first.iov_len -= currentOffset;
+	std::size_t written = fileDescriptor.writev(&first, static_cast<int>(count));
+	first = saved;
+
+	if(written == FileDescriptor::wouldBlock) {
+		return 0;
+	}
+	if(written == FileDescriptor::npos) {
+		currentIndex = buffers.size();
+		return FileDescriptor::npos;
+	}
+
+	/* partial writes may end anywhere, also within a buffer */
+	std::size_t remaining = written;
+	while(remaining > 0) {
+		std::size_t left = buffers[currentIndex].iov_len - currentOffset;
+		if(remaining < left) {
+			currentOffset += remaining;
+			break;
+		}
+		remaining -= left;
+		++currentIndex;
+		currentOffset = 0;
+	}
+
+	return written;
+}
+
+const std::vector<struct iovec>& ProducerIovec::getBuffers() const noexcept {
+	return buffers;
+}
+
+std::size_t ProducerIovec::getSize() const noexcept {
+	return size;
+}
+
+} /* namespace process */
+} /* namespace zsystem */
@@ -0,0 +1,66 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_PRODUCERIOVEC_H_
+#define ZSYSTEM_PROCESS_PRODUCERIOVEC_H_
+
+#include <zsystem/process/Producer.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <sys/uio.h>
+
+#include <string>
+#include <vector>
+
+namespace zsystem {
+namespace process {
+
+/* ProducerIovec writes a list of buffers, e.g. header, body and trailer, by writev without concatenating them.
+ * The buffers are not owned, they must stay valid until the producer is finished. */
+class ProducerIovec : public Producer {
+public:
+	ProducerIovec() = default;
+
+	void add(const char* data, std::size_t size);
+	void add(const std::string& str);
+
+	std::size_t produce(FileDescriptor& fileDescriptor) override;
+
+	const std::vector<struct iovec>& getBuffers() const noexcept;
+
+	/* sum of the sizes of all buffers */
+	std::size_t getSize() const noexcept;
+
+private:
+	std::vector<struct iovec> buffers;
+	std::size_t size = 0;
+
+	/* first buffer not written completely and the number of its bytes already written */
+	std::size_t currentIndex = 0;
+	std::size_t currentOffset = 0;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_PRODUCERIOVEC_H_ */
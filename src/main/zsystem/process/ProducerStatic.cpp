@@ -31,19 +31,33 @@ ProducerStatic::ProducerStatic(const char* aData, std::size_t aSize)
 { }
 
 std::size_t ProducerStatic::produce(process::FileDescriptor& fileDescriptor) {
-	std::size_t count = fileDescriptor.write(getData(), getSize() - currentPos);
+	if(currentPos >= getSize()) {
+		return process::FileDescriptor::npos;
+	}
 
-	if(count != 0) {
-		if(count == process::FileDescriptor::npos) {
-			/* error occurred. set currentPos to the end of the content */
-			currentPos = getSize();
-		}
-		else {
-			currentPos += count;
+	std::size_t count = process::FileDescriptor::notSupported;
+	if(zeroCopy) {
+		count = fileDescriptor.vmsplice(getData() + currentPos, getSize() - currentPos);
+		if(count == process::FileDescriptor::notSupported) {
+			zeroCopy = false;
 		}
 	}
+	if(count == process::FileDescriptor::notSupported) {
+		count = fileDescriptor.write(getData() + currentPos, getSize() - currentPos);
+	}
+
+	if(count == process::FileDescriptor::wouldBlock) {
+		return 0;
+	}
+	if(count == process::FileDescriptor::npos) {
+		/* error occurred. set currentPos to the end of the content */
+		currentPos = getSize();
+		return process::FileDescriptor::npos;
+	}
+	currentPos += count;
 
-	return (currentPos < getSize()) ? count : process::FileDescriptor::npos;
+	/* report the last chunk as written, next call returns npos */
+	return count;
 }
 
 const char* ProducerStatic::getData() const noexcept {
@@ -54,5 +68,13 @@ std::size_t ProducerStatic::getSize() const noexcept {
 	return size;
 }
 
+void ProducerStatic::setZeroCopy(bool aZeroCopy) noexcept {
+	zeroCopy = aZeroCopy;
+}
+
+bool ProducerStatic::isZeroCopy() const noexcept {
+	return zeroCopy;
+}
+
 } /* namespace process */
 } /* namespace zsystem */
@@ -40,10 +40,18 @@ public:
 	const char* getData() const noexcept;
 	std::size_t getSize() const noexcept;
 
+	/* Zero copy maps the pages of data into the pipe by vmsplice instead of writing them.
+	 * IMPORTANT: The child reads the memory of the caller then. data must stay valid and unchanged
+	 * until the execution has finished, not only until produce() has returned.
+	 * Falls back to write if the child is not connected by a pipe, isZeroCopy() returns false then. Default: false */
+	void setZeroCopy(bool zeroCopy) noexcept;
+	bool isZeroCopy() const noexcept;
+
 private:
 	const char* data;
 	std::size_t size;
 	std::size_t currentPos = 0;
+	bool zeroCopy = false;
 };
 
 } /* namespace process */
@@ -0,0 +1,208 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_STATICSTREAM_H_
+#define ZSYSTEM_PROCESS_STATICSTREAM_H_
+
+#include <zsystem/process/BufferPool.h>
+#include <zsystem/process/Consumer.h>
+#include <zsystem/process/FileDescriptor.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace zsystem {
+namespace process {
+
+/* Adapters for Process::executeStatic. They are instantiated for the concrete type of a producer or consumer,
+ * so the compiler sees the whole per-chunk path and can inline it. Accepted are
+ * - objects with produce(FileDescriptor&) or consume(FileDescriptor&), e.g. ProducerStatic or ConsumerString.
+ *   Their virtual functions are called without dynamic dispatch, because the concrete type is known.
+ *   T is a reference for an lvalue passed to executeStatic, so the caller can read a ConsumerString afterwards,
+ *   a temporary is moved in and held by value.
+ * - callables "std::size_t(char* data, std::size_t size)" for producers, that fill data and return the number
+ *   of bytes or 0 at the end, like the function of ProducerDynamic.
+ * - callables "bool(const char* data, std::size_t size)" for consumers, that return false if no more data is desired. */
+template<typename T>
+struct HasProduce {
+private:
+	template<typename U>
+	static auto test(int) -> decltype(std::declval<U&>().produce(std::declval<FileDescriptor&>()), std::true_type());
+	template<typename U>
+	static std::false_type test(...);
+
+public:
+	static constexpr bool value = decltype(test<T>(0))::value;
+};
+
+template<typename T>
+struct HasConsume {
+private:
+	template<typename U>
+	static auto test(int) -> decltype(std::declval<U&>().consume(std::declval<FileDescriptor&>()), std::true_type());
+	template<typename U>
+	static std::false_type test(...);
+
+public:
+	static constexpr bool value = decltype(test<T>(0))::value;
+};
+
+template<typename T, bool isProducer = HasProduce<T>::value>
+class StaticProducer {
+public:
+	StaticProducer(T aProducer)
+	: producer(std::forward<T>(aProducer))
+	{ }
+
+	std::size_t produce(FileDescriptor& fileDescriptor) {
+		return producer.produce(fileDescriptor);
+	}
+
+private:
+	T producer;
+};
+
+template<typename T>
+class StaticProducer<T, false> {
+public:
+	StaticProducer(T aFunction)
+	: function(std::forward<T>(aFunction))
+	{ }
+
+	std::size_t produce(FileDescriptor& fileDescriptor) {
+		if(currentPos >= currentSize) {
+			buffer = BufferPool::getDefault(chunkSize.get()).acquire();
+			currentPos = 0;
+			currentSize = function(buffer.getData(), chunkSize.get());
+			if(currentSize == 0) {
+				buffer.release();
+				return FileDescriptor::npos;
+			}
+		}
+
+		std::size_t count = fileDescriptor.write(&buffer.getData()[currentPos], currentSize - currentPos);
+		if(count == FileDescriptor::wouldBlock) {
+			return 0;
+		}
+		if(count == FileDescriptor::npos) {
+			buffer.release();
+			return FileDescriptor::npos;
+		}
+		currentPos += count;
+		chunkSize.update(count);
+
+		if(currentPos >= currentSize) {
+			buffer.release();
+		}
+
+		return count;
+	}
+
+private:
+	T function;
+	BufferPool::Buffer buffer;
+	ChunkSize chunkSize;
+	std::size_t currentPos = 0;
+	std::size_t currentSize = 0;
+};
+
+template<typename T, bool isConsumer = HasConsume<T>::value>
+class StaticConsumer {
+public:
+	StaticConsumer(T aConsumer)
+	: consumer(std::forward<T>(aConsumer))
+	{ }
+
+	bool consume(FileDescriptor& fileDescriptor) {
+		return consumer.consume(fileDescriptor);
+	}
+
+	bool flushPending() {
+		return flushPending(consumer, std::is_base_of<Consumer, typename std::remove_reference<T>::type>());
+	}
+
+	FileDescriptor::Handle getPendingHandle() const noexcept {
+		return getPendingHandle(consumer, std::is_base_of<Consumer, typename std::remove_reference<T>::type>());
+	}
+
+private:
+	static bool flushPending(T& aConsumer, std::true_type) {
+		return aConsumer.flushPending();
+	}
+
+	static bool flushPending(T&, std::false_type) {
+		return true;
+	}
+
+	static FileDescriptor::Handle getPendingHandle(const T& aConsumer, std::true_type) noexcept {
+		return aConsumer.getPendingHandle();
+	}
+
+	static FileDescriptor::Handle getPendingHandle(const T&, std::false_type) noexcept {
+		return FileDescriptor::noHandle;
+	}
+
+	T consumer;
+};
+
+template<typename T>
+class StaticConsumer<T, false> {
+public:
+	StaticConsumer(T aFunction)
+	: function(std::forward<T>(aFunction))
+	{ }
+
+	bool consume(FileDescriptor& fileDescriptor) {
+		BufferPool::Buffer buffer = BufferPool::getDefault(chunkSize.get()).acquire();
+
+		std::size_t count = fileDescriptor.read(buffer.getData(), chunkSize.get());
+		if(count == FileDescriptor::npos) {
+			return false;
+		}
+		if(count == FileDescriptor::wouldBlock || count == 0) {
+			/* end of file is detected by the I/O loop, see Process::isEndOfFile */
+			return true;
+		}
+		chunkSize.update(count);
+
+		return function(static_cast<const char*>(buffer.getData()), count);
+	}
+
+	bool flushPending() {
+		return true;
+	}
+
+	FileDescriptor::Handle getPendingHandle() const noexcept {
+		return FileDescriptor::noHandle;
+	}
+
+private:
+	T function;
+	ChunkSize chunkSize;
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_STATICSTREAM_H_ */
@@ -0,0 +1,177 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include <zsystem/process/TimerWheel.h>
+
+namespace zsystem {
+namespace process {
+
+const std::uint64_t TimerWheel::noTick = static_cast<std::uint64_t>(-1);
+
+TimerWheel::Timer::~Timer() {
+	if(timerWheel) {
+		timerWheel->cancel(*this);
+	}
+}
+
+bool TimerWheel::Timer::isActive() const noexcept {
+	return timerWheel != nullptr;
+}
+
+TimerWheel::TimerWheel(std::uint64_t aCurrentTick)
+: currentTick(aCurrentTick)
+{ }
+
+TimerWheel::~TimerWheel() {
+	for(unsigned int level = 0; level < levels; ++level) {
+		for(unsigned int slot = 0; slot < slots; ++slot) {
+			while(wheel[level][slot]) {
+				cancel(*wheel[level][slot]);
+			}
+		}
+	}
+}
+
+void TimerWheel::add(Timer& timer, std::uint64_t expiryTick) noexcept {
+	if(timer.timerWheel) {
+		timer.timerWheel->cancel(timer);
+	}
+
+	timer.expiryTick = expiryTick;
+	timer.timerWheel = this;
+	++count;
+	insert(timer, currentTick + 1);
+}
+
+void TimerWheel::cancel(Timer& timer) noexcept {
+	if(timer.timerWheel != this) {
+		return;
+	}
+
+	if(timer.prev) {
+		timer.prev->next = timer.next;
+	}
+	else {
+		*timer.slot = timer.next;
+	}
+	if(timer.next) {
+		timer.next->prev = timer.prev;
+	}
+
+	timer.prev = nullptr;
+	timer.next = nullptr;
+	timer.slot = nullptr;
+	timer.timerWheel = nullptr;
+	--count;
+}
+
+void TimerWheel::advance(std::uint64_t tick) {
+	while(currentTick < tick) {
+		/* skip ticks without anything to do */
+		std::uint64_t nextTick = getNextTick();
+		if(nextTick == noTick || nextTick > tick) {
+			currentTick = tick;
+			break;
+		}
+		currentTick = nextTick;
+
+		/* cascade timers of the next higher level if a level wraps around */
+		for(unsigned int level = 1; level < levels; ++level) {
+			if((currentTick >> (slotBits * (level - 1))) & (slots - 1)) {
+				break;
+			}
+			cascade(level);
+		}
+
+		Timer*& head = wheel[0][currentTick & (slots - 1)];
+		while(head) {
+			Timer& timer = *head;
+			cancel(timer);
+			timer.onExpired();
+		}
+	}
+}
+
+std::uint64_t TimerWheel::getCurrentTick() const noexcept {
+	return currentTick;
+}
+
+std::uint64_t TimerWheel::getNextTick() const noexcept {
+	if(count == 0) {
+		return noTick;
+	}
+
+	std::uint64_t nextTick = noTick;
+	for(unsigned int level = 0; level < levels; ++level) {
+		unsigned int shift = slotBits * level;
+		for(std::uint64_t i = 1; i <= slots; ++i) {
+			std::uint64_t slot = (currentTick >> shift) + i;
+			if(wheel[level][slot & (slots - 1)]) {
+				if((slot << shift) < nextTick) {
+					nextTick = slot << shift;
+				}
+				break;
+			}
+		}
+	}
+
+	return nextTick;
+}
+
+void TimerWheel::insert(Timer& timer, std::uint64_t minTick) noexcept {
+	std::uint64_t expiryTick = (timer.expiryTick > minTick) ? timer.expiryTick : minTick;
+	std::uint64_t delta = expiryTick - currentTick;
+
+	unsigned int level = 0;
+	while(level < levels - 1 && delta >= (std::uint64_t(1) << (slotBits * (level + 1)))) {
+		++level;
+	}
+	if(delta >= (std::uint64_t(1) << (slotBits * levels))) {
+		/* beyond the range of the wheel, will be cascaded to the last slot again */
+		expiryTick = currentTick + (std::uint64_t(1) << (slotBits * levels)) - 1;
+	}
+
+	Timer*& head = wheel[level][(expiryTick >> (slotBits * level)) & (slots - 1)];
+	timer.prev = nullptr;
+	timer.next = head;
+	timer.slot = &head;
+	if(head) {
+		head->prev = &timer;
+	}
+	head = &timer;
+}
+
+void TimerWheel::cascade(unsigned int level) noexcept {
+	Timer* timer = wheel[level][(currentTick >> (slotBits * level)) & (slots - 1)];
+	wheel[level][(currentTick >> (slotBits * level)) & (slots - 1)] = nullptr;
+
+	while(timer) {
+		Timer* next = timer->next;
+		/* timers expiring now are moved to the current slot of level 0, it is expired after cascading */
+		insert(*timer, currentTick);
+		timer = next;
+	}
+}
+
+} /* namespace process */
+} /* namespace zsystem */
@@ -0,0 +1,106 @@
+/*
+MIT License
+Copyright (c) 2019-2021 Sven Lukas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ZSYSTEM_PROCESS_TIMERWHEEL_H_
+#define ZSYSTEM_PROCESS_TIMERWHEEL_H_
+
+#include <cstdint>
+
+namespace zsystem {
+namespace process {
+
+/* Hierarchical timer wheel with 4 levels of 64 slots each.
+ *
+ * Time is measured in ticks. A timer expiring within 64 ticks is stored in level 0, within 64^2 ticks in level 1
+ * and so on. When the wheel of a level wraps around, the next slot of the level above is cascaded down.
+ * Timers are intrusive and doubly linked, so add() and cancel() are O(1) and do not allocate.
+ * Timers beyond 64^4 ticks are stored in the last slot of level 3 and cascaded again when they reach it.
+ *
+ * TimerWheel is not thread-safe. It is driven by the owner calling advance(), e.g. if a timerfd armed to
+ * getNextTick() becomes readable.
+ */
+class TimerWheel {
+public:
+	class Timer {
+	public:
+		Timer() = default;
+		Timer(const Timer&) = delete;
+		virtual ~Timer();
+
+		Timer& operator=(const Timer&) = delete;
+
+		bool isActive() const noexcept;
+
+	protected:
+		/* called by TimerWheel::advance(). The timer is not active anymore and can be added again. */
+		virtual void onExpired() = 0;
+
+	private:
+		friend class TimerWheel;
+
+		Timer* prev = nullptr;
+		Timer* next = nullptr;
+		Timer** slot = nullptr;
+		TimerWheel* timerWheel = nullptr;
+		std::uint64_t expiryTick = 0;
+	};
+
+	static const std::uint64_t noTick;
+
+	TimerWheel(std::uint64_t currentTick = 0);
+	TimerWheel(const TimerWheel&) = delete;
+	~TimerWheel();
+
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	/* (re-)arms timer to expire at expiryTick. Expiry ticks in the past expire with the next tick. */
+	void add(Timer& timer, std::uint64_t expiryTick) noexcept;
+	void cancel(Timer& timer) noexcept;
+
+	/* expires all timers up to tick */
+	void advance(std::uint64_t tick);
+
+	std::uint64_t getCurrentTick() const noexcept;
+
+	/* returns the tick at which advance() has to be called next, or noTick if there is no timer.
+	 * This is the expiry tick of the next timer or an earlier tick at which a level has to be cascaded. */
+	std::uint64_t getNextTick() const noexcept;
+
+private:
+	static const unsigned int levels = 4;
+	static const unsigned int slotBits = 6;
+	static const unsigned int slots = 1 << slotBits;
+
+	/* timers expiring before minTick are inserted at minTick */
+	void insert(Timer& timer, std::uint64_t minTick) noexcept;
+	void cascade(unsigned int level) noexcept;
+
+	std::uint64_t currentTick;
+	std::uint64_t count = 0;
+	Timer* wheel[levels][slots] = {};
+};
+
+} /* namespace process */
+} /* namespace zsystem */
+
+#endif /* ZSYSTEM_PROCESS_TIMERWHEEL_H_ */
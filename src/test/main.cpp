@@ -1,43 +1,239 @@
 #include <zsystem/SharedMemory.h>
 #include <zsystem/Process.h>
+#include <zsystem/ConcurrencyController.h>
+#include <zsystem/CoprocessPool.h>
+#include <zsystem/ProcessCache.h>
+#include <zsystem/Reaper.h>
+#include <zsystem/ShardedProcess.h>
+#include <zsystem/Sha256.h>
+#include <zsystem/Signal.h>
+#include <zsystem/SingleFlight.h>
+#include <zsystem/Supervisor.h>
 #include <zsystem/process/Arguments.h>
 #include <zsystem/process/Environment.h>
 #include <zsystem/process/Consumer.h>
+#include <zsystem/process/ConsumerBatch.h>
+#include <zsystem/process/ConsumerBudget.h>
+#include <zsystem/process/ConsumerFeeder.h>
 #include <zsystem/process/ConsumerFile.h>
+#include <zsystem/process/ConsumerSpan.h>
+#include <zsystem/process/ConsumerString.h>
 #include <zsystem/process/ProducerStatic.h>
 #include <zsystem/process/ProducerFile.h>
+#include <zsystem/process/ProducerIovec.h>
 #include <zsystem/process/FileDescriptor.h>
+#include <zsystem/process/FeatureProcess.h>
+#include <zsystem/process/FeatureThrottle.h>
+#include <zsystem/process/FeatureTime.h>
+#include <zsystem/process/FeatureTimeout.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <ftw.h>
+#include <sys/resource.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace zsystem;
 using namespace zsystem::process;
 
+/* counts all heap allocations of the program, used by testcase 23 */
+std::atomic<std::size_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+	++allocationCount;
+	void* ptr = std::malloc(size ? size : 1);
+	if(ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
 std::string produceStr = "Hello\n"
 		"World!\n";
 
-class MyConsumer : public Consumer {
+class MyConsumer : public ConsumerSpan {
 public:
 	MyConsumer() = default;
 
+	bool consumeData(const char* data, std::size_t count) override {
+		std::string str(data, count);
+		std::cout << "CONSUMED (" << count << " bytes)\n"
+				<< "*** CONSUMED BEGIN ***\n"
+				<< str << "\n"
+				<< "*** CONSUMED END ***\n"
+				<< "\n";
+		return true;
+		//return count;
+	}
+};
+
+class StringConsumer : public Consumer {
+public:
 	bool consume(FileDescriptor& fileDescriptor) override {
 		char buffer[4096];
 		std::size_t count = fileDescriptor.read(buffer, sizeof(buffer));
 		if(count == FileDescriptor::npos) {
 			return false;
 		}
+		if(count == FileDescriptor::wouldBlock) {
+			return true;
+		}
 
-		std::string str(buffer, count);
-		std::cout << "CONSUMED (" << count << " bytes)\n"
-				<< "*** CONSUMED BEGIN ***\n"
-				<< str << "\n"
-				<< "*** CONSUMED END ***\n"
-				<< "\n";
+		str.append(buffer, count);
 		return true;
-		//return count;
 	}
+
+	std::string str;
+};
+
+/* counts the calls and bytes it gets as span */
+class CountingSpanConsumer : public ConsumerSpan {
+public:
+	bool consumeData(const char*, std::size_t size) override {
+		++calls;
+		bytes += size;
+		return true;
+	}
+
+	std::size_t calls = 0;
+	std::size_t bytes = 0;
+};
+
+/* passes spans to a function */
+class ConsumerCallback : public ConsumerSpan {
+public:
+	ConsumerCallback(std::function<bool(const char*, std::size_t)> aFunction)
+	: function(std::move(aFunction))
+	{ }
+
+	bool consumeData(const char* data, std::size_t size) override {
+		return function(data, size);
+	}
+
+private:
+	std::function<bool(const char*, std::size_t)> function;
+};
+
+/* counts the heap allocations between two calls of consume, it does not allocate anything itself */
+class AllocationConsumer : public Consumer {
+public:
+	bool consume(FileDescriptor& fileDescriptor) override {
+		std::size_t currentAllocationCount = allocationCount;
+		if(calls > 0) {
+			allocations += currentAllocationCount - lastAllocationCount;
+		}
+		++calls;
+
+		std::size_t count = fileDescriptor.read(buffer, sizeof(buffer));
+		if(count == FileDescriptor::npos) {
+			return false;
+		}
+		if(count == FileDescriptor::wouldBlock) {
+			return true;
+		}
+		bytes += count;
+
+		lastAllocationCount = allocationCount;
+		return true;
+	}
+
+	char buffer[4096];
+	std::size_t calls = 0;
+	std::size_t bytes = 0;
+	std::size_t allocations = 0;
+	std::size_t lastAllocationCount = 0;
+};
+
+/* limits the CPU time of the child by setrlimit, that is async-signal-safe and must be called in the child */
+class FeatureCpuLimit : public Feature {
+public:
+	FeatureCpuLimit(rlim_t aSeconds)
+	: seconds(aSeconds)
+	{ }
+
+	bool onChild() noexcept override {
+		struct rlimit limit;
+		limit.rlim_cur = seconds;
+		limit.rlim_max = seconds + 1;
+		return setrlimit(RLIMIT_CPU, &limit) == 0;
+	}
+
+	void onIteration() override {
+		++iterations;
+	}
+
+	rlim_t seconds;
+	std::size_t iterations = 0;
 };
 
+/* number of processes in a process group, that are not terminated yet (zombies are not counted) */
+int countGroup(Process::Handle group) {
+	int count = 0;
+
+	DIR* dir = opendir("/proc");
+	if(!dir) {
+		return -1;
+	}
+	while(struct dirent* entry = readdir(dir)) {
+		std::ifstream file(std::string("/proc/") + entry->d_name + "/stat");
+		std::string stat;
+		if(!std::getline(file, stat)) {
+			continue;
+		}
+
+		/* fields after "pid (comm)": state ppid pgrp */
+		std::istringstream fields(stat.substr(stat.rfind(')') + 1));
+		char state;
+		Process::Handle ppid;
+		Process::Handle pgrp;
+		if(fields >> state >> ppid >> pgrp && pgrp == group && state != 'Z') {
+			++count;
+		}
+	}
+	closedir(dir);
+
+	return count;
+}
+
+/* returns syscr + syscw of this process */
+std::size_t getReadWriteSyscalls() {
+	std::ifstream io("/proc/self/io");
+	std::string key;
+	std::size_t value;
+	std::size_t syscalls = 0;
+	while(io >> key >> value) {
+		if(key == "syscr:" || key == "syscw:") {
+			syscalls += value;
+		}
+	}
+	return syscalls;
+}
+
+/* returns the content of a file, empty if it cannot be read */
+std::string readFile(const std::string& filename) {
+	std::ifstream file(filename, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
 void printTestcase_1() {
 	std::cout <<
 			"  1  Execute \"/usr/bin/kwrite\".\n"
@@ -149,6 +345,354 @@ void printTestcase_9() {
 			"\n";
 }
 
+void printTestcase_10() {
+	std::cout <<
+			" 10  Execute \"/usr/bin/timeout 2 /usr/bin/sha256sum /dev/zero\" 16 times by 8 threads.\n"
+			"     - Each thread acquires a slot of a ConcurrencyController before executing the CPU burning child.\n"
+			"     - Close stdin.\n"
+			"     - Close stdout.\n"
+			"     - Not closing stderr.\n"
+			"     Result:\n"
+			"     - Every decision of the ConcurrencyController is displayed.\n"
+			"     - Limit should back off as soon as the CPU pressure exceeds the threshold.\n"
+			"\n";
+}
+
+void printTestcase_11() {
+	std::cout <<
+			" 11  Execute \"/usr/bin/sh -c exit\\ 3\" 256 times by 16 threads while a Reaper is installed.\n"
+			"     - Close stdin.\n"
+			"     - Close stdout.\n"
+			"     - Not closing stderr.\n"
+			"     - A terminated child that is not registered at the Reaper stays a zombie meanwhile.\n"
+			"     Result:\n"
+			"     - All children are reaped by the Reaper.\n"
+			"     - Every execution should return 3.\n"
+			"     - The unregistered child is left to its owner.\n"
+			"     - Registering a child twice throws, its result is still passed on once.\n"
+			"\n";
+}
+
+void printTestcase_12() {
+	std::cout <<
+			" 12  Execute \"/usr/bin/cat\" 640 times by 64 threads concurrently.\n"
+			"     - Redirect stdin to OWN PRODUCER with content specific for thread and iteration.\n"
+			"     - Redirect stdout to OWN CONSUMER.\n"
+			"     - Not closing stderr.\n"
+			"     Result:\n"
+			"     - Every consumer should receive exactly the content of its own producer.\n"
+			"\n";
+}
+
+void printTestcase_13() {
+	std::cout <<
+			" 13  Execute \"/usr/bin/sed s/a/A/g\" sharded by 4 workers with chunks of 1024 bytes.\n"
+			"     - Redirect \"./data/lorem_ipsum.txt\" to stdin of the shards.\n"
+			"     - Redirect stdout of the shards to OWN CONSUMER.\n"
+			"     - Not closing stderr.\n"
+			"     - Execute \"/bin/sh -c 'read x; echo $x; exec sleep $x'\" sharded by 4 workers with input \"0 5 5 5\",\n"
+			"       one line per chunk, into a consumer that does not want any data.\n"
+			"     Result:\n"
+			"     - Consumer should receive the same content as a single \"sed\" produces.\n"
+			"     - Execution is aborted after the first chunk, the sleeping children are killed: rc=0 after < 1s.\n"
+			"\n";
+}
+
+void printTestcase_14() {
+	std::cout <<
+			" 14  Send 10000 requests to a CoprocessPool of 2 \"/usr/bin/cat\" workers by 4 threads.\n"
+			"     - \"cat\" echos every length prefixed request.\n"
+			"     - Workers are recycled after 1000 requests.\n"
+			"     - A request of 16 MiB, larger than the socket buffers.\n"
+			"     - \"/bin/sleep 10\" as worker, that never responds, with a timeout of 200ms.\n"
+			"     - \"/usr/bin/cat\" as worker with delimiter ';' and 4 requests \"request <i>;extra\", so every response are two frames.\n"
+			"     Result:\n"
+			"     - Every response should be equal to its request.\n"
+			"     - Average round trip time per request is displayed.\n"
+			"     - The response of 16 MiB is equal to the request.\n"
+			"     - The call fails after about 200ms with timeouts=1.\n"
+			"     - No call returns the extra frame of a previous request (stale=0), the calls fail instead (failed=4).\n"
+			"\n";
+}
+
+void printTestcase_15() {
+	std::cout <<
+			" 15  Supervise 2 workers \"/bin/sh -c 'test -S /proc/self/fd/3 && exec sleep 60'\" on UNIX socket\n"
+			"     \"/tmp/zsystem-supervisor.sock\".\n"
+			"     - Kill one worker with SIGKILL.\n"
+			"     - Do a rolling restart.\n"
+			"     - Supervise 2 workers \"/bin/sleep 60\" with notifyHandle 4 and readyTimeout 200ms.\n"
+			"     Result:\n"
+			"     - Killed worker is restarted.\n"
+			"     - All workers have new handles after the rolling restart.\n"
+			"     - starts=5 restarts=1 running=2.\n"
+			"     - start() of the workers that never become ready throws, no worker is left behind.\n"
+			"\n";
+}
+
+void printTestcase_16() {
+	std::cout <<
+			" 16  Start \"/bin/sh -c 'sleep 0.3; echo STATUS=initialized >&$ZSYSTEM_NOTIFY_FD; echo READY=1 >&$ZSYSTEM_NOTIFY_FD; sleep 60'\"\n"
+			"     with readiness notification at handle 3 and wait up to 5s until it is ready.\n"
+			"     - Start \"/usr/bin/sleep 60\" with readiness notification and wait up to 200ms until it is ready.\n"
+			"     - Start a child that writes READY=1 and then 20000 STATUS lines (more than the pipe capacity) and wait for it.\n"
+			"     - Start a child with readiness notification at handle 3 and a file descriptor of its own at handle 3.\n"
+			"     Result:\n"
+			"     - First child is ready after about 300ms with status \"initialized\".\n"
+			"     - Second child is not ready.\n"
+			"     - Third child terminates with status \"done\", its Process has still no environment of its own.\n"
+			"     - start() throws because of the conflict, no child is started.\n"
+			"\n";
+}
+
+void printTestcase_17() {
+	std::cout <<
+			" 17  Execute \"/usr/bin/sha256sum\" 100 times through a ProcessCache in a new directory \"/tmp/zsystem-cache-XXXXXX\".\n"
+			"     - Redirect \"./data/lorem_ipsum.txt\" to stdin.\n"
+			"     - Redirect stdout to OWN CONSUMER.\n"
+			"     Result:\n"
+			"     - Output should be the SHA-256 of \"./data/lorem_ipsum.txt\" every time.\n"
+			"     - First execution is a miss, all other executions are hits: hits=99 misses=1 stores=1.\n"
+			"     - Average time of misses and hits is displayed.\n"
+			"     - The directory is removed afterwards.\n"
+			"\n";
+}
+
+void printTestcase_18() {
+	std::cout <<
+			" 18  Execute \"/bin/sh -c 'sleep 0.2; echo probe; exit 4'\" by 32 threads at the same time through SingleFlight.\n"
+			"     - Redirect stdout to OWN CONSUMER of each thread.\n"
+			"     Result:\n"
+			"     - Only one child is started (executions=1 coalesced=31).\n"
+			"     - Every thread gets return code 4 and output \"probe\".\n"
+			"\n";
+}
+
+void printTestcase_19() {
+	std::cout <<
+			" 19  Execute children with FeatureTimeout.\n"
+			"     - \"/usr/bin/sleep 10\" with soft timeout 200ms.\n"
+			"     - \"/bin/sh -c 'trap \"\" TERM; exec sleep 10'\" with soft timeout 100ms and hard timeout 300ms.\n"
+			"     - \"/bin/sh -c 'echo a; sleep 0.1; echo b; exec sleep 10'\" with idle timeout 300ms, stdout to OWN CONSUMER.\n"
+			"     Result:\n"
+			"     - rc=143 reason=soft after about 200ms.\n"
+			"     - rc=137 reason=hard after about 300ms.\n"
+			"     - rc=143 reason=idle after about 400ms, consumer received \"a\" and \"b\".\n"
+			"\n";
+}
+
+void printTestcase_20() {
+	std::cout <<
+			" 20  Execute children with FeatureThrottle of 25% CPU share.\n"
+			"     - \"/bin/sh -c 'while :; do :; done'\" with hard timeout 3s.\n"
+			"     - \"/usr/bin/sleep 1\".\n"
+			"     - \"/bin/sh\" in its own process group with two busy \"sha256sum /dev/zero\" children, hard timeout 3s.\n"
+			"     - \"/bin/sh\" in its own process group, busy itself, with a busy child and a busy grandchild, hard timeout 3s.\n"
+			"     Result:\n"
+			"     - Busy loop gets 25% +- 3% CPU time of the elapsed time.\n"
+			"     - Sleeping child is never stopped and sampled about once per period.\n"
+			"     - The whole group gets 25% +- 3% CPU time of the elapsed time.\n"
+			"     - The whole group including leader and grandchild gets 25% +- 3% CPU time of the elapsed time.\n"
+			"\n";
+}
+
+void printTestcase_21() {
+	std::cout <<
+			" 21  Execute children with ConsumerBudget.\n"
+			"     - \"/usr/bin/yes\" with a budget of 10 lines and FeatureProcess.\n"
+			"     - \"/usr/bin/yes\" with a budget of 10 lines without FeatureProcess.\n"
+			"     - \"/usr/bin/cat ./data/lorem_ipsum.txt\" with a budget of 100 bytes.\n"
+			"     - \"/usr/bin/printf a,b,c,d\" with a budget of 2 records delimited by ','.\n"
+			"     Result:\n"
+			"     - rc=143 (SIGTERM), output is exactly 10 lines \"y\".\n"
+			"     - rc=141 (SIGPIPE), output is exactly 10 lines \"y\".\n"
+			"     - output is the first 100 bytes of \"./data/lorem_ipsum.txt\".\n"
+			"     - output is \"a,b,\".\n"
+			"\n";
+}
+
+void printTestcase_22() {
+	std::cout <<
+			" 22  Start and execute children in their own process group.\n"
+			"     - Start \"/bin/sh -c sleep 10 & sleep 10 & wait\" in a new process group and terminate the group.\n"
+			"     - Execute the same command with a hard timeout of 200ms, the grandchildren keep stdout open.\n"
+			"       The shell writes its pid to stdout, that is the id of the process group.\n"
+			"     Result:\n"
+			"     - running=3 before, rc=143 (SIGTERM) and running=0 after terminating the group.\n"
+			"     - rc=137 (SIGKILL) after ~200ms and running=0.\n"
+			"\n";
+}
+
+void printTestcase_23() {
+	std::cout <<
+			" 23  Count heap allocations of the parent loop.\n"
+			"     - \"/usr/bin/head -c 104857600 /dev/zero\", stdout is read in chunks of 4 KiB.\n"
+			"     - Same command with an idle timeout of 10s, so the timer is part of the loop.\n"
+			"     Result:\n"
+			"     - rc=0 bytes=104857600 allocations=0 for thousands of iterations.\n"
+			"     - rc=0 bytes=104857600 allocations=0 for thousands of iterations.\n"
+			"\n";
+}
+
+void printTestcase_24() {
+	std::cout <<
+			" 24  Stream data through children with non-blocking handles.\n"
+			"     - Write 16 MiB to \"/usr/bin/cat\" and read its stdout at the same time.\n"
+			"     - Write 16 MiB to \"/usr/bin/head -c 10\", that stops reading after 10 bytes.\n"
+			"     - \"/usr/bin/yes\" into a ConsumerFile on a non-blocking pipe, hard timeout 300ms.\n"
+			"       The pipe is not read and closed after 1s.\n"
+			"     - 1 MiB by \"/usr/bin/head\" into a ConsumerFile on a non-blocking pipe that is read after 200ms,\n"
+			"       by executeStatic and by execute on a socketpair.\n"
+			"     Result:\n"
+			"     - rc=0 and the output is equal to the input. Blocking writes would deadlock,\n"
+			"       because \"cat\" blocks on its full stdout while the parent blocks on writing.\n"
+			"     - rc=0 and output is 10 bytes, the parent is not killed by SIGPIPE.\n"
+			"     - rc=137 (SIGKILL) and reason=hard, the full target does not block the timer of the parent loop.\n"
+			"       Otherwise \"yes\" would be terminated by SIGPIPE after 1s.\n"
+			"     - rc=0 and 1048576 bytes, data pending at the end of the child is written.\n"
+			"       iterations < 1000, the parent loop waits for the full target instead of spinning on the pipe.\n"
+			"\n";
+}
+
+void printTestcase_25() {
+	std::cout <<
+			" 25  Execute \"/usr/bin/sha256sum /dev/zero\" with FeatureTime and a custom feature.\n"
+			"     - The custom feature sets RLIMIT_CPU to 1s in the child and counts the iterations of the parent loop.\n"
+			"     - stdout is read by a consumer.\n"
+			"     Result:\n"
+			"     - rc=152 (SIGXCPU) after about 1000ms, user time is about 1000ms.\n"
+			"     - iterations=1, because sha256sum writes nothing and its stdout is closed at exit.\n"
+			"\n";
+}
+
+void printTestcase_26() {
+	std::cout <<
+			" 26  Stream data through \"/usr/bin/cat\" by Process::executeStatic.\n"
+			"     - Producer and consumer are lambdas, 16 MiB are written to stdin and read from stdout.\n"
+			"     - Producer is a ProducerStatic by value, consumer a lambda, with FeatureTime.\n"
+			"     - Producer is a ProducerStatic by value, consumer a ConsumerString by reference.\n"
+			"     Result:\n"
+			"     - rc=0 and the output is equal to the input.\n"
+			"     - rc=0 and the output is equal to the input, real time is displayed.\n"
+			"     - rc=0 and the ConsumerString of the caller contains the output.\n"
+			"\n";
+}
+
+void printTestcase_27() {
+	std::cout <<
+			" 27  Span consumers with the library owned buffer pool.\n"
+			"     - 16 MiB through \"/usr/bin/cat\" into a ConsumerSpan, that counts calls and bytes.\n"
+			"     - 16 MiB fed by ConsumerFeeder to a ConsumerString and to a plain Consumer.\n"
+			"     Result:\n"
+			"     - rc=0, 16777216 bytes and the average bytes per call, up to 65536 if the pipe is filled fast enough.\n"
+			"     - both strings are equal to the input, the ConsumerString got them without a pipe.\n"
+			"\n";
+}
+
+void printTestcase_28() {
+	std::cout <<
+			" 28  Pipe capacity and adaptive chunk sizes.\n"
+			"     - Raise a pipe to /proc/sys/fs/pipe-max-size and a socketpair to 1 MiB.\n"
+			"     - 16 MiB through \"/usr/bin/cat\" with Process::setStreamBufferSize on stdin and stdout.\n"
+			"     Result:\n"
+			"     - pipe-max-size and the pipe size are equal, socket buffer size is set.\n"
+			"     - rc=0, 16777216 bytes and more than 65536 bytes per call, because the chunk size grows.\n"
+			"\n";
+}
+
+void printTestcase_29() {
+	std::cout <<
+			" 29  Batch the output of a chatty child by ConsumerBatch.\n"
+			"     - \"/bin/sh\" writes 2000 lines by separate writes, consumed directly and by ConsumerBatch(4096, 65536, 50ms).\n"
+			"     - \"/bin/sh\" writes one line, sleeps 1s and writes another one, ConsumerBatch(4096, 65536, 100ms).\n"
+			"     Result:\n"
+			"     - same bytes, far less calls of the consumer with ConsumerBatch.\n"
+			"     - 2 batches, the first one is delivered after about 100ms plus the start of the shell, not after 1s.\n"
+			"     - The parent loop iterates a few times only, the wakeup is armed only while data is collected.\n"
+			"\n";
+}
+
+void printTestcase_30() {
+	std::cout <<
+			" 30  Scatter/gather I/O.\n"
+			"     - ProducerIovec writes a header, 3000 parts of a body and a trailer to \"/usr/bin/cat\" through\n"
+			"       a pipe of 4096 bytes, so writes end within parts and exceed IOV_MAX parts.\n"
+			"     - ProcessKey of the ProducerIovec and of the concatenated input.\n"
+			"     - pwrite, pread and readv on a temporary file.\n"
+			"     Result:\n"
+			"     - rc=0 and the output is equal to the concatenated input.\n"
+			"     - keys are equal.\n"
+			"     - \"Hello World!\" is read back.\n"
+			"\n";
+}
+
+void printTestcase_31() {
+	std::cout <<
+			" 31  Execute \"/usr/bin/cat\" with 1 MiB input twice and count the allocations from the global heap.\n"
+			"     - Arguments, Environment and Process use the default memory resource.\n"
+			"     - Arguments, Environment and Process use a std::pmr::monotonic_buffer_resource on the stack.\n"
+			"     Only with a build with -DZSYSTEM_PMR=ON.\n"
+			"     Result:\n"
+			"     - rc=0 and some global allocations.\n"
+			"     - rc=0 and 1 global allocation for the Environment object passed by std::unique_ptr, all other memory comes from the arena.\n"
+			"\n";
+}
+
+void printTestcase_32() {
+	std::cout <<
+			" 32  Move 16 MiB from a file through \"/usr/bin/cat\" to a file by Process::executeStatic,\n"
+			"     ProducerFile and ConsumerFile.\n"
+			"     - read and write syscalls of this process are counted by /proc/self/io.\n"
+			"     - ConsumerFile and ProducerFile on a socketpair, where splice is not possible.\n"
+			"     Result:\n"
+			"     - rc=0, output file is equal to the input file and about 520 read and write syscalls instead of about 1400.\n"
+			"       Nearly all of them are done by \"/usr/bin/cat\", its counters are added when it is reaped.\n"
+			"       Data is moved by splice in this process.\n"
+			"     - \"Hello World!\" by the fallback to read and write.\n"
+			"\n";
+}
+
+void printTestcase_33() {
+	std::cout <<
+			" 33  Write 16 MiB by ProducerStatic with zero copy to \"/usr/bin/cat\".\n"
+			"     - ProducerStatic::setZeroCopy(true) on stdin, that is a pipe.\n"
+			"     - ProducerStatic::setZeroCopy(true) on a socketpair.\n"
+			"     Result:\n"
+			"     - rc=0, output is equal to the input and zero copy is still used.\n"
+			"     - \"Hello World!\" by the fallback to write, zero copy is not used anymore.\n"
+			"\n";
+}
+
+void printTestcase_34() {
+	std::cout <<
+			" 34  ProducerFile with a memory mapped file on a socketpair, where splice is not possible.\n"
+			"     - 100 MiB and 123 bytes, larger than ProducerFile::mapWindowSize and not a multiple of the page size.\n"
+			"     - The first 5000 bytes are read before, so the mapping starts within a page.\n"
+			"     - A thread reads the other side of the socketpair.\n"
+			"     Result:\n"
+			"     - Output is equal to the input without the first 5000 bytes.\n"
+			"\n";
+}
+
+void printTestcase_35() {
+	std::cout <<
+			" 35  Execute \"/bin/sh -c 'read line; echo got $line >&0'\" with a producer and a consumer on stdin.\n"
+			"     - Stdin is a socketpair, ProducerStatic writes \"hello\" and ConsumerString reads the answer.\n"
+			"     Result:\n"
+			"     - rc=0 output=ok, the consumer receives \"got hello\" and execute returns after the child has closed the socket,\n"
+			"       although the socket stays readable at end of file.\n"
+			"\n";
+}
+
+void printTestcase_36() {
+	std::cout <<
+			" 36  Execute \"/usr/bin/sleep 0.5\" with a feature that throws in onSpawn, then execute it again without the feature.\n"
+			"     Result:\n"
+			"     - execute throws, the child is killed and reaped at once, not after 500ms.\n"
+			"     - The second execute returns rc=0 instead of throwing \"child is still running\".\n"
+			"\n";
+}
+
 void printUsage() {
 	std::cout <<
 			"zprocess testcase\n"
@@ -162,6 +706,33 @@ void printUsage() {
 	printTestcase_7();
 	printTestcase_8();
 	printTestcase_9();
+	printTestcase_10();
+	printTestcase_11();
+	printTestcase_12();
+	printTestcase_13();
+	printTestcase_14();
+	printTestcase_15();
+	printTestcase_16();
+	printTestcase_17();
+	printTestcase_18();
+	printTestcase_19();
+	printTestcase_20();
+	printTestcase_21();
+	printTestcase_22();
+	printTestcase_23();
+	printTestcase_24();
+	printTestcase_25();
+	printTestcase_26();
+	printTestcase_27();
+	printTestcase_28();
+	printTestcase_29();
+	printTestcase_30();
+	printTestcase_31();
+	printTestcase_32();
+	printTestcase_33();
+	printTestcase_34();
+	printTestcase_35();
+	printTestcase_36();
 }
 
 int main(int argc, char* argv[]) {
@@ -256,6 +827,1140 @@ int main(int argc, char* argv[]) {
 			std::cout << "\n\nExecuted testcase:\n";
 			printTestcase_9();
 		}
+		else if(testcase == "10") {
+			ConcurrencyController::Settings settings;
+			settings.interval = std::chrono::milliseconds(250);
+
+			ConcurrencyController concurrencyController(settings);
+			concurrencyController.setDecisionHandler([](const ConcurrencyController::Metrics& metrics) {
+				std::cout << "limit=" << metrics.limit << " inFlight=" << metrics.inFlight
+						<< " cpu=" << metrics.cpuPressure << " memory=" << metrics.memoryPressure << " io=" << metrics.ioPressure
+						<< " loadavg=" << metrics.loadAverage << "\n";
+			});
+
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 8; ++i) {
+				threads.emplace_back([&concurrencyController]() {
+					for(int j = 0; j < 2; ++j) {
+						ConcurrencyController::Slot slot = concurrencyController.acquire();
+
+						Process process(Arguments("/usr/bin/timeout 2 /usr/bin/sha256sum /dev/zero"));
+						process.execute(FileDescriptor::stdErrHandle);
+					}
+				});
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+
+			ConcurrencyController::Metrics metrics = concurrencyController.getMetrics();
+			std::cout << "peakInFlight=" << metrics.peakInFlight << " increases=" << metrics.increases
+					<< " decreases=" << metrics.decreases << " waits=" << metrics.waits << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_10();
+		}
+		else if(testcase == "11") {
+			Reaper reaper;
+			std::atomic<int> failures(0);
+
+			pid_t foreignPid = fork();
+			if(foreignPid == 0) {
+				_exit(7);
+			}
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 16; ++i) {
+				threads.emplace_back([&failures]() {
+					for(int j = 0; j < 16; ++j) {
+						Process process(Arguments("/usr/bin/sh -c exit\\ 3"));
+						if(process.execute(FileDescriptor::stdErrHandle) != 3) {
+							++failures;
+						}
+					}
+				});
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+			int foreignStatus = 0;
+			bool foreignLeft = waitpid(foreignPid, &foreignStatus, 0) == foreignPid && WEXITSTATUS(foreignStatus) == 7;
+
+			std::cout << "failures=" << failures << " foreign=" << (foreignLeft ? "left to owner" : "reaped") << " after " << elapsed.count() << "ms\n";
+
+			pid_t twicePid = fork();
+			if(twicePid == 0) {
+				_exit(5);
+			}
+			FileDescriptor twicePidFileDescriptor = FileDescriptor::openProcess(twicePid);
+			reaper.add(twicePid, twicePidFileDescriptor.getHandle());
+			bool twiceThrown = false;
+			try {
+				reaper.add(twicePid, twicePidFileDescriptor.getHandle());
+			}
+			catch(const std::runtime_error&) {
+				twiceThrown = true;
+			}
+			int twiceStatus = reaper.wait(twicePid).status;
+			std::cout << "twice=" << (twiceThrown ? "thrown" : "replaced") << " exit=" << WEXITSTATUS(twiceStatus) << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_11();
+		}
+		else if(testcase == "12") {
+			std::atomic<int> failures(0);
+
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 64; ++i) {
+				threads.emplace_back([&failures, i]() {
+					for(int j = 0; j < 10; ++j) {
+						std::string content = "thread " + std::to_string(i) + " iteration " + std::to_string(j) + "\n";
+						ProducerStatic myProducer(content.data(), content.size());
+						StringConsumer myConsumer;
+
+						Process process(Arguments("/usr/bin/cat"));
+						int rc = process.execute(myProducer, FileDescriptor::stdInHandle, myConsumer, FileDescriptor::stdOutHandle, FileDescriptor::stdErrHandle);
+						if(rc != 0 || myConsumer.str != content) {
+							++failures;
+						}
+					}
+				});
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+
+			std::cout << "failures=" << failures << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_12();
+		}
+		else if(testcase == "13") {
+			ConsumerString expected;
+			ProducerFile expectedProducer(FileDescriptor::openFile("./data/lorem_ipsum.txt", true, false, false));
+			Process process(Arguments("/usr/bin/sed s/a/A/g"));
+			process.execute(expectedProducer, FileDescriptor::stdInHandle, expected, FileDescriptor::stdOutHandle, FileDescriptor::stdErrHandle);
+
+			ConsumerString myConsumer;
+			FileDescriptor input = FileDescriptor::openFile("./data/lorem_ipsum.txt", true, false, false);
+			ShardedProcess shardedProcess(Arguments("/usr/bin/sed s/a/A/g"), 4);
+			shardedProcess.setChunkSize(1024);
+			int rc = shardedProcess.execute(input, myConsumer);
+
+			std::cout << "rc=" << rc << " size=" << myConsumer.getString().size()
+					<< (myConsumer.getString() == expected.getString() ? " equal" : " NOT EQUAL") << "\n";
+
+			/* does not want any data */
+			class StopConsumer : public ConsumerSpan {
+			public:
+				bool consumeData(const char*, std::size_t) override {
+					return false;
+				}
+			};
+
+			std::pair<FileDescriptor, FileDescriptor> pipe = FileDescriptor::openUnidirectional();
+			pipe.second.write("0\n5\n5\n5\n", 8);
+			pipe.second.close();
+
+			StopConsumer stopConsumer;
+			ShardedProcess sleepingProcess(Arguments("/bin/sh -c read\\ x;echo\\ $x;exec\\ sleep\\ $x"), 4);
+			sleepingProcess.setChunkSize(2);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			rc = sleepingProcess.execute(pipe.first, stopConsumer);
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "stopped: rc=" << rc << " after " << (elapsed.count() < 1000 ? "< 1s" : ">= 1s") << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_13();
+		}
+		else if(testcase == "14") {
+			CoprocessPool::Settings settings;
+			settings.workers = 2;
+			settings.maxRequests = 1000;
+
+			CoprocessPool coprocessPool(Arguments("/usr/bin/cat"), settings);
+			coprocessPool.start();
+
+			std::atomic<int> failures(0);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 4; ++i) {
+				threads.emplace_back([&coprocessPool, &failures, i]() {
+					for(int j = 0; j < 2500; ++j) {
+						std::string request = "request " + std::to_string(i) + "/" + std::to_string(j);
+						if(coprocessPool.call(request) != request) {
+							++failures;
+						}
+					}
+				});
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+
+			std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+			CoprocessPool::Metrics metrics = coprocessPool.getMetrics();
+			std::cout << "failures=" << failures << " requests=" << metrics.requests << " starts=" << metrics.starts
+					<< " restarts=" << metrics.restarts << " recycles=" << metrics.recycles
+					<< " avg=" << (elapsed.count() / metrics.requests) << "us\n";
+
+			std::string largeRequest(16 * 1024 * 1024, 'x');
+			std::cout << "large: " << (coprocessPool.call(largeRequest) == largeRequest ? "equal" : "different") << "\n";
+
+			{
+				CoprocessPool::Settings sleepSettings;
+				sleepSettings.timeout = std::chrono::milliseconds(200);
+				CoprocessPool sleepPool(Arguments("/bin/sleep 10"), sleepSettings);
+
+				start = std::chrono::steady_clock::now();
+				try {
+					sleepPool.call("request");
+					std::cout << "timeout: no exception\n";
+				}
+				catch(const std::exception& e) {
+					std::chrono::duration<double, std::milli> timeoutElapsed = std::chrono::steady_clock::now() - start;
+					std::cout << "timeout: " << e.what() << " after " << timeoutElapsed.count() << "ms"
+							<< " timeouts=" << sleepPool.getMetrics().timeouts << "\n";
+				}
+			}
+
+			{
+				CoprocessPool::Settings twiceSettings;
+				twiceSettings.framing = CoprocessPool::Framing::delimiter;
+				twiceSettings.delimiter = ';';
+				CoprocessPool twicePool(Arguments("/usr/bin/cat"), twiceSettings);
+
+				int ok = 0;
+				int stale = 0;
+				int failed = 0;
+				for(int i = 0; i < 4; ++i) {
+					std::string request = "request " + std::to_string(i);
+					try {
+						if(twicePool.call(request + ";extra") == request) {
+							++ok;
+						}
+						else {
+							++stale;
+						}
+					}
+					catch(const std::exception&) {
+						++failed;
+					}
+				}
+				std::cout << "twice: ok=" << ok << " stale=" << stale << " failed=" << failed << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_14();
+		}
+		else if(testcase == "15") {
+			Supervisor::Settings settings;
+			settings.workers = 2;
+			settings.unixPath = "/tmp/zsystem-supervisor.sock";
+			settings.restartDelay = std::chrono::milliseconds(200);
+
+			Supervisor supervisor(Arguments("/bin/sh -c test\\ -S\\ /proc/self/fd/3\\ &&\\ exec\\ sleep\\ 60"), settings);
+			supervisor.start();
+
+			std::vector<Process::Handle> handles = supervisor.getHandles();
+			Signal::sendSignal(handles.at(0), Signal::Type::kill);
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+			std::vector<Process::Handle> handlesRestarted = supervisor.getHandles();
+			supervisor.rollingRestart();
+			std::vector<Process::Handle> handlesRolled = supervisor.getHandles();
+
+			bool restarted = handlesRestarted.size() == 2 && handlesRestarted.at(0) != handles.at(0) && handlesRestarted.at(1) == handles.at(1);
+			bool rolled = handlesRolled.size() == 2 && handlesRolled.at(0) != handlesRestarted.at(0) && handlesRolled.at(1) != handlesRestarted.at(1);
+
+			Supervisor::Metrics metrics = supervisor.getMetrics();
+			std::cout << "restarted=" << restarted << " rolled=" << rolled << " starts=" << metrics.starts
+					<< " restarts=" << metrics.restarts << " running=" << metrics.running << "\n";
+			supervisor.stop();
+
+			Supervisor::Settings notReadySettings = settings;
+			notReadySettings.notifyHandle = 4;
+			notReadySettings.readyTimeout = std::chrono::milliseconds(200);
+			Supervisor notReadySupervisor(Arguments("/bin/sleep 60"), notReadySettings);
+			try {
+				notReadySupervisor.start();
+				std::cout << "not ready: started\n";
+			}
+			catch(const std::runtime_error& e) {
+				std::cout << "not ready: " << e.what() << " running=" << notReadySupervisor.getMetrics().running << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_15();
+		}
+		else if(testcase == "16") {
+			Process process(Arguments("/bin/sh -c sleep\\ 0.3;echo\\ STATUS=initialized\\ >&$ZSYSTEM_NOTIFY_FD;echo\\ READY=1\\ >&$ZSYSTEM_NOTIFY_FD;sleep\\ 60"));
+			process.setNotify(3);
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			process.start(Process::ChildFileDescriptors());
+			bool ready = process.waitReady(std::chrono::milliseconds(5000));
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "ready=" << ready << " status=\"" << process.getStatus() << "\" after " << elapsed.count() << "ms\n";
+
+			Process processNotReady(Arguments("/usr/bin/sleep 60"));
+			processNotReady.setNotify(3);
+			processNotReady.start(Process::ChildFileDescriptors());
+			std::cout << "ready=" << processNotReady.waitReady(std::chrono::milliseconds(200)) << "\n";
+
+			Signal::sendSignal(process.getHandle(), Signal::Type::kill);
+			Signal::sendSignal(processNotReady.getHandle(), Signal::Type::kill);
+			process.wait();
+			processNotReady.wait();
+
+			Process processChatty(Arguments("/bin/sh -c echo\\ READY=1\\ >&$ZSYSTEM_NOTIFY_FD;seq\\ -f\\ STATUS=%g\\ 20000\\ >&$ZSYSTEM_NOTIFY_FD;echo\\ STATUS=done\\ >&$ZSYSTEM_NOTIFY_FD"));
+			processChatty.setNotify(3);
+			processChatty.start(Process::ChildFileDescriptors());
+			int rc = processChatty.wait();
+			std::cout << "rc=" << rc << " ready=" << processChatty.isReady() << " status=\"" << processChatty.getStatus()
+					<< "\" environment=" << (processChatty.getEnvironment() != nullptr) << "\n";
+
+			Process processConflict(Arguments("/usr/bin/true"));
+			processConflict.setNotify(3);
+			Process::ChildFileDescriptors childFileDescriptors;
+			childFileDescriptors[3] = FileDescriptor::openFile("/dev/null", false, true, false);
+			try {
+				processConflict.start(std::move(childFileDescriptors));
+				std::cout << "conflict: started\n";
+				processConflict.wait();
+			}
+			catch(const std::runtime_error& e) {
+				std::cout << "conflict: " << e.what() << " handle=" << processConflict.getHandle() << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_16();
+		}
+		else if(testcase == "17") {
+			std::ifstream file("./data/lorem_ipsum.txt", std::ios::binary);
+			std::stringstream content;
+			content << file.rdbuf();
+			Sha256 sha256;
+			sha256.update(content.str());
+			std::string expected = sha256.getHex() + "  -\n";
+
+			char directory[] = "/tmp/zsystem-cache-XXXXXX";
+			if(mkdtemp(directory) == nullptr) {
+				throw std::runtime_error(std::string("mkdtemp failed: ") + std::strerror(errno));
+			}
+
+			ProcessCache::Settings settings;
+			settings.directory = directory;
+			ProcessCache processCache(settings);
+
+			int failures = 0;
+			std::chrono::duration<double, std::micro> missTime(0);
+			std::chrono::duration<double, std::micro> hitTime(0);
+			for(int i = 0; i < 100; ++i) {
+				Process process(Arguments("/usr/bin/sha256sum"));
+				ProducerFile producer(FileDescriptor::openFile("./data/lorem_ipsum.txt", true, false, false));
+				StringConsumer consumer;
+
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				std::uint64_t hits = processCache.getMetrics().hits;
+
+				ProcessKey processKey(Arguments("/usr/bin/sha256sum"));
+				processKey.addInput(producer);
+				if(processCache.execute(process, processKey, &producer, &consumer, nullptr) != 0 || consumer.str != expected) {
+					++failures;
+				}
+
+				if(processCache.getMetrics().hits == hits) {
+					missTime += std::chrono::steady_clock::now() - start;
+				}
+				else {
+					hitTime += std::chrono::steady_clock::now() - start;
+				}
+			}
+
+			ProcessCache::Metrics metrics = processCache.getMetrics();
+			std::cout << "failures=" << failures << " hits=" << metrics.hits << " misses=" << metrics.misses << " stores=" << metrics.stores
+					<< " size=" << metrics.size << "\n";
+			if(metrics.misses > 0) {
+				std::cout << "avg miss=" << (missTime.count() / metrics.misses) << "us\n";
+			}
+			if(metrics.hits > 0) {
+				std::cout << "avg hit=" << (hitTime.count() / metrics.hits) << "us\n";
+			}
+
+			nftw(directory, [](const char* path, const struct stat*, int, struct FTW*) {
+				return remove(path);
+			}, 16, FTW_DEPTH | FTW_PHYS);
+			std::cout << "removed=" << (access(directory, F_OK) == -1) << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_17();
+		}
+		else if(testcase == "18") {
+			SingleFlight singleFlight;
+			std::atomic<int> failures(0);
+
+			std::vector<std::thread> threads;
+			for(int i = 0; i < 32; ++i) {
+				threads.emplace_back([&singleFlight, &failures]() {
+					Arguments arguments("/bin/sh -c sleep\\ 0.2;echo\\ probe;exit\\ 4");
+					Process process(arguments);
+					ProcessKey processKey(arguments);
+					StringConsumer consumer;
+
+					if(singleFlight.execute(process, processKey, nullptr, &consumer, nullptr) != 4 || consumer.str != "probe\n") {
+						++failures;
+					}
+				});
+			}
+			for(auto& thread : threads) {
+				thread.join();
+			}
+
+			SingleFlight::Metrics metrics = singleFlight.getMetrics();
+			std::cout << "failures=" << failures << " executions=" << metrics.executions << " coalesced=" << metrics.coalesced << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_18();
+		}
+		else if(testcase == "19") {
+			const char* reasons[] = { "none", "soft", "hard", "idle" };
+
+			{
+				FeatureTimeout featureTimeout;
+				featureTimeout.setSoftTimeout(std::chrono::milliseconds(200));
+
+				Process process(Arguments("/usr/bin/sleep 10"));
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				int rc = process.execute(featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				std::cout << "rc=" << rc << " reason=" << reasons[static_cast<int>(featureTimeout.getReason())] << " after " << elapsed.count() << "ms\n";
+			}
+
+			{
+				FeatureTimeout featureTimeout;
+				featureTimeout.setSoftTimeout(std::chrono::milliseconds(100));
+				featureTimeout.setHardTimeout(std::chrono::milliseconds(300));
+
+				Process process(Arguments("/bin/sh -c trap\\ \\\"\\\"\\ TERM;exec\\ sleep\\ 10"));
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				int rc = process.execute(featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				std::cout << "rc=" << rc << " reason=" << reasons[static_cast<int>(featureTimeout.getReason())] << " after " << elapsed.count() << "ms\n";
+			}
+
+			{
+				FeatureTimeout featureTimeout;
+				featureTimeout.setIdleTimeout(std::chrono::milliseconds(300));
+				StringConsumer consumer;
+
+				Process process(Arguments("/bin/sh -c echo\\ a;sleep\\ 0.1;echo\\ b;exec\\ sleep\\ 10"));
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle, featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				std::cout << "rc=" << rc << " reason=" << reasons[static_cast<int>(featureTimeout.getReason())] << " after " << elapsed.count() << "ms"
+						<< " output=" << (consumer.str == "a\nb\n" ? "ok" : "wrong") << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_19();
+		}
+		else if(testcase == "20") {
+			{
+				FeatureThrottle featureThrottle;
+				featureThrottle.setCpuShare(0.25);
+				FeatureTimeout featureTimeout;
+				featureTimeout.setHardTimeout(std::chrono::milliseconds(3000));
+
+				Process process(Arguments("/bin/sh -c while\\ :;do\\ :;done"));
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				process.execute(featureThrottle, featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+				const FeatureThrottle::Statistics& statistics = featureThrottle.getStatistics();
+				double cpuMs = static_cast<double>(statistics.cpuTime.count()) / 1000000.0;
+				std::cout << "cpu=" << cpuMs << "ms elapsed=" << elapsed.count() << "ms share=" << (100.0 * cpuMs / elapsed.count())
+						<< "% samples=" << statistics.samples << " stops=" << statistics.stops << "\n";
+			}
+
+			{
+				FeatureThrottle featureThrottle;
+				featureThrottle.setCpuShare(0.25);
+
+				Process process(Arguments("/usr/bin/sleep 1"));
+				process.execute(featureThrottle);
+
+				const FeatureThrottle::Statistics& statistics = featureThrottle.getStatistics();
+				std::cout << "samples=" << statistics.samples << " stops=" << statistics.stops << "\n";
+			}
+
+			{
+				FeatureThrottle featureThrottle;
+				featureThrottle.setCpuShare(0.25);
+				FeatureTimeout featureTimeout;
+				featureTimeout.setHardTimeout(std::chrono::milliseconds(3000));
+
+				Process process(Arguments("/bin/sh -c sha256sum\\ /dev/zero&sha256sum\\ /dev/zero;wait"));
+				process.setGroup(Process::Group::processGroup);
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				process.execute(featureThrottle, featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+				const FeatureThrottle::Statistics& statistics = featureThrottle.getStatistics();
+				double cpuMs = static_cast<double>(statistics.cpuTime.count()) / 1000000.0;
+				std::cout << "group: cpu=" << cpuMs << "ms elapsed=" << elapsed.count() << "ms share=" << (100.0 * cpuMs / elapsed.count())
+						<< "% samples=" << statistics.samples << " stops=" << statistics.stops << "\n";
+			}
+
+			{
+				FeatureThrottle featureThrottle;
+				featureThrottle.setCpuShare(0.25);
+				FeatureTimeout featureTimeout;
+				featureTimeout.setHardTimeout(std::chrono::milliseconds(3000));
+
+				/* the subshell forks sha256sum, so it is a grandchild of the leader */
+				Process process(Arguments("/bin/sh -c sha256sum\\ /dev/zero&(sha256sum\\ /dev/zero&wait)&while\\ :;do\\ :;done"));
+				process.setGroup(Process::Group::processGroup);
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				process.execute(featureThrottle, featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+				const FeatureThrottle::Statistics& statistics = featureThrottle.getStatistics();
+				double cpuMs = static_cast<double>(statistics.cpuTime.count()) / 1000000.0;
+				std::cout << "leader and grandchild: cpu=" << cpuMs << "ms elapsed=" << elapsed.count() << "ms share=" << (100.0 * cpuMs / elapsed.count())
+						<< "% samples=" << statistics.samples << " stops=" << statistics.stops << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_20();
+		}
+		else if(testcase == "21") {
+			std::string expected;
+			for(int i = 0; i < 10; ++i) {
+				expected += "y\n";
+			}
+
+			{
+				FeatureProcess featureProcess;
+				ConsumerBudget consumer(ConsumerBudget::Unit::lines, 10, &featureProcess);
+
+				Process process(Arguments("/usr/bin/yes"));
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle, featureProcess);
+				std::cout << "rc=" << rc << " output=" << (consumer.getString() == expected ? "ok" : "wrong") << "\n";
+			}
+
+			{
+				ConsumerBudget consumer(ConsumerBudget::Unit::lines, 10);
+
+				Process process(Arguments("/usr/bin/yes"));
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " output=" << (consumer.getString() == expected ? "ok" : "wrong") << "\n";
+			}
+
+			{
+				std::ifstream file("./data/lorem_ipsum.txt", std::ios::binary);
+				std::stringstream content;
+				content << file.rdbuf();
+
+				ConsumerBudget consumer(ConsumerBudget::Unit::bytes, 100);
+
+				Process process(Arguments("/usr/bin/cat ./data/lorem_ipsum.txt"));
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " output=" << (consumer.getString() == content.str().substr(0, 100) ? "ok" : "wrong") << "\n";
+			}
+
+			{
+				ConsumerBudget consumer(ConsumerBudget::Unit::records, 2, nullptr, ',');
+
+				Process process(Arguments("/usr/bin/printf a,b,c,d"));
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " output=\"" << consumer.getString() << "\"\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_21();
+		}
+		else if(testcase == "22") {
+			{
+				Process process(Arguments("/bin/sh -c sleep\\ 10\\ &\\ sleep\\ 10\\ &\\ wait"));
+				process.setGroup(Process::Group::processGroup);
+				Process::Handle group = process.start(Process::ChildFileDescriptors());
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				std::cout << "running=" << countGroup(group) << "\n";
+
+				Signal::sendGroupSignal(process, Signal::Type::terminate);
+				int rc = process.wait();
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				std::cout << "rc=" << rc << " running=" << countGroup(group) << "\n";
+			}
+
+			{
+				FeatureTimeout featureTimeout;
+				featureTimeout.setHardTimeout(std::chrono::milliseconds(200));
+				StringConsumer consumer;
+
+				Process process(Arguments("/bin/sh -c echo\\ $$;sleep\\ 10\\ &\\ sleep\\ 10\\ &\\ wait"));
+				process.setGroup(Process::Group::processGroup);
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle, featureTimeout);
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				Process::Handle group = std::stoi(consumer.str);
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				std::cout << "rc=" << rc << " after " << elapsed.count() << "ms running=" << countGroup(group) << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_22();
+		}
+		else if(testcase == "23") {
+			{
+				AllocationConsumer consumer;
+
+				Process process(Arguments("/usr/bin/head -c 104857600 /dev/zero"));
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " bytes=" << consumer.bytes << " iterations=" << consumer.calls << " allocations=" << consumer.allocations << "\n";
+			}
+
+			{
+				AllocationConsumer consumer;
+				FeatureTimeout featureTimeout;
+				featureTimeout.setIdleTimeout(std::chrono::seconds(10));
+
+				Process process(Arguments("/usr/bin/head -c 104857600 /dev/zero"));
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle, featureTimeout);
+				std::cout << "rc=" << rc << " bytes=" << consumer.bytes << " iterations=" << consumer.calls << " allocations=" << consumer.allocations << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_23();
+		}
+		else if(testcase == "24") {
+			std::string input(16 * 1024 * 1024, 0);
+			for(std::size_t i = 0; i < input.size(); ++i) {
+				input[i] = static_cast<char>('a' + i % 26);
+			}
+
+			{
+				ProducerStatic producer(input.data(), input.size());
+				ConsumerString consumer;
+
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " output=" << (consumer.getString() == input ? "equal" : "different") << "\n";
+			}
+
+			{
+				ProducerStatic producer(input.data(), input.size());
+				ConsumerString consumer;
+
+				Process process(Arguments("/usr/bin/head -c 10"));
+				int rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " output=" << consumer.getString().size() << " bytes\n";
+			}
+
+			{
+				std::pair<FileDescriptor, FileDescriptor> target = FileDescriptor::openUnidirectional();
+				target.second.setBlocking(false);
+				FeatureTimeout featureTimeout;
+				featureTimeout.setHardTimeout(std::chrono::milliseconds(300));
+
+				/* closing the reader lets writes fail, so the parent loop can finish */
+				std::thread closer([&target]() {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+					target.first.close();
+				});
+
+				const char* reasons[] = { "none", "soft", "hard", "idle" };
+				Process process(Arguments("/usr/bin/yes"));
+				int rc = process.executeStatic(ProducerStatic(nullptr, 0), ConsumerFile(std::move(target.second)), featureTimeout);
+				closer.join();
+				std::cout << "rc=" << rc << " reason=" << reasons[static_cast<int>(featureTimeout.getReason())] << "\n";
+			}
+
+			for(bool isStatic : { true, false }) {
+				std::pair<FileDescriptor, FileDescriptor> target = FileDescriptor::openUnidirectional();
+				target.second.setBlocking(false);
+
+				std::size_t bytes = 0;
+				std::thread reader([&target, &bytes]() {
+					std::this_thread::sleep_for(std::chrono::milliseconds(200));
+					char buffer[65536];
+					std::size_t count;
+					while((count = target.first.read(buffer, sizeof(buffer))) != 0 && count != FileDescriptor::npos) {
+						bytes += count;
+					}
+				});
+
+				/* counts the iterations of the parent loop only */
+				FeatureCpuLimit featureCpuLimit(10);
+				int rc;
+				{
+					Process process(Arguments("/usr/bin/head -c 1048576 /dev/zero"));
+					ConsumerFile consumer(std::move(target.second));
+					if(isStatic) {
+						rc = process.executeStatic(ProducerStatic(nullptr, 0), consumer, featureCpuLimit);
+					}
+					else {
+						/* with a producer on the same handle the parent loop reads from a socketpair,
+						 * otherwise execute passes the file of the ConsumerFile to the child */
+						ProducerStatic producer(nullptr, 0);
+						rc = process.execute(producer, FileDescriptor::stdOutHandle, consumer, FileDescriptor::stdOutHandle, featureCpuLimit);
+					}
+				}
+				reader.join();
+				std::cout << (isStatic ? "executeStatic" : "execute") << ": rc=" << rc << " output=" << bytes << " bytes"
+						<< " iterations" << (featureCpuLimit.iterations < 1000 ? " < 1000" : " >= 1000") << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_24();
+		}
+		else if(testcase == "25") {
+			FeatureTime featureTime;
+			FeatureCpuLimit featureCpuLimit(1);
+			StringConsumer consumer;
+
+			Process process(Arguments("/usr/bin/sha256sum /dev/zero"));
+			int rc = process.execute(consumer, FileDescriptor::stdOutHandle, featureTime, featureCpuLimit);
+			std::cout << "rc=" << rc << " real=" << featureTime.getRealMS() << "ms user=" << featureTime.getUserMS() << "ms sys=" << featureTime.getSysMS() << "ms"
+					<< " iterations=" << featureCpuLimit.iterations << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_25();
+		}
+		else if(testcase == "26") {
+			std::string input(16 * 1024 * 1024, 0);
+			for(std::size_t i = 0; i < input.size(); ++i) {
+				input[i] = static_cast<char>('a' + i % 26);
+			}
+
+			{
+				std::size_t pos = 0;
+				std::string output;
+
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.executeStatic(
+						[&input, &pos](char* data, std::size_t size) {
+							size = std::min(size, input.size() - pos);
+							std::memcpy(data, &input[pos], size);
+							pos += size;
+							return size;
+						},
+						[&output](const char* data, std::size_t size) {
+							output.append(data, size);
+							return true;
+						});
+				std::cout << "rc=" << rc << " output=" << (output == input ? "equal" : "different") << "\n";
+			}
+
+			{
+				std::string output;
+				FeatureTime featureTime;
+
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.executeStatic(ProducerStatic(input.data(), input.size()),
+						[&output](const char* data, std::size_t size) {
+							output.append(data, size);
+							return true;
+						},
+						featureTime);
+				std::cout << "rc=" << rc << " output=" << (output == input ? "equal" : "different") << " real=" << featureTime.getRealMS() << "ms\n";
+			}
+
+			{
+				ConsumerString consumer;
+
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.executeStatic(ProducerStatic(input.data(), input.size()), consumer);
+				std::cout << "rc=" << rc << " ConsumerString: " << (consumer.getString() == input ? "equal" : "different") << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_26();
+		}
+		else if(testcase == "27") {
+			std::string input(16 * 1024 * 1024, 0);
+			for(std::size_t i = 0; i < input.size(); ++i) {
+				input[i] = static_cast<char>('a' + i % 26);
+			}
+
+			{
+				ProducerStatic producer(input.data(), input.size());
+				CountingSpanConsumer consumer;
+
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " bytes=" << consumer.bytes << " calls=" << consumer.calls
+						<< " bytes/call=" << (consumer.calls > 0 ? consumer.bytes / consumer.calls : 0) << "\n";
+			}
+
+			{
+				ConsumerString consumerString;
+				StringConsumer stringConsumer;
+				ConsumerFeeder spanFeeder(consumerString);
+				ConsumerFeeder pipeFeeder(stringConsumer);
+
+				for(std::size_t pos = 0; pos < input.size(); pos += 1000) {
+					std::size_t size = std::min<std::size_t>(1000, input.size() - pos);
+					spanFeeder.feed(&input[pos], size);
+					pipeFeeder.feed(&input[pos], size);
+				}
+				spanFeeder.close();
+				pipeFeeder.close();
+
+				std::cout << "ConsumerString: " << (consumerString.getString() == input ? "equal" : "different") << "\n";
+				std::cout << "Consumer:       " << (stringConsumer.str == input ? "equal" : "different") << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_27();
+		}
+		else if(testcase == "28") {
+			{
+				std::pair<FileDescriptor, FileDescriptor> pipe = FileDescriptor::openUnidirectional();
+				std::size_t pipeSize = pipe.first.setPipeSize(FileDescriptor::getPipeMaxSize());
+				std::cout << "pipe-max-size=" << FileDescriptor::getPipeMaxSize() << " pipe-size=" << pipeSize << "\n";
+
+				std::pair<FileDescriptor, FileDescriptor> socket = FileDescriptor::openBidirectional();
+				std::cout << "socket-buffer-size " << (socket.first.setSocketBufferSize(1024 * 1024) ? "set" : "failed") << "\n";
+			}
+
+			{
+				std::string input(16 * 1024 * 1024, 'x');
+				ProducerStatic producer(input.data(), input.size());
+				CountingSpanConsumer consumer;
+
+				Process process(Arguments("/usr/bin/cat"));
+				process.setStreamBufferSize(FileDescriptor::stdInHandle, FileDescriptor::getPipeMaxSize());
+				process.setStreamBufferSize(FileDescriptor::stdOutHandle, FileDescriptor::getPipeMaxSize());
+				int rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " bytes=" << consumer.bytes << " calls=" << consumer.calls
+						<< " bytes/call=" << (consumer.calls > 0 ? consumer.bytes / consumer.calls : 0) << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_28();
+		}
+		else if(testcase == "29") {
+			const std::string chatty = "/bin/sh -c i=0;while\\ [\\ $i\\ -lt\\ 2000\\ ];do\\ echo\\ line$i;i=$((i+1));done";
+
+			{
+				CountingSpanConsumer consumer;
+
+				Process process{Arguments(chatty)};
+				int rc = process.execute(consumer, FileDescriptor::stdOutHandle);
+				std::cout << "direct: rc=" << rc << " bytes=" << consumer.bytes << " calls=" << consumer.calls << "\n";
+			}
+
+			{
+				CountingSpanConsumer consumer;
+				ConsumerBatch consumerBatch(consumer, 4096, 65536, std::chrono::milliseconds(50));
+
+				Process process{Arguments(chatty)};
+				int rc = process.execute(consumerBatch, FileDescriptor::stdOutHandle, consumerBatch.getFeature());
+				std::cout << "batch:  rc=" << rc << " bytes=" << consumer.bytes << " calls=" << consumer.calls << "\n";
+			}
+
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				std::vector<double> deliveries;
+				ConsumerCallback consumer([&start, &deliveries](const char*, std::size_t) {
+					deliveries.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+					return true;
+				});
+				ConsumerBatch consumerBatch(consumer, 4096, 65536, std::chrono::milliseconds(100));
+
+				/* counts the iterations of the parent loop only */
+				FeatureCpuLimit featureIterations(10);
+
+				Process process(Arguments("/bin/sh -c echo\\ a;sleep\\ 1;echo\\ b"));
+				int rc = process.execute(consumerBatch, FileDescriptor::stdOutHandle, consumerBatch.getFeature(), featureIterations);
+				std::cout << "latency: rc=" << rc << " batches=" << consumerBatch.getBatchCount();
+				for(double delivery : deliveries) {
+					std::cout << " " << static_cast<long>(delivery) << "ms";
+				}
+				std::cout << " iterations=" << featureIterations.iterations << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_29();
+		}
+		else if(testcase == "30") {
+			std::string header = "HEADER\n";
+			std::string trailer = "TRAILER\n";
+			std::vector<std::string> parts;
+			for(std::size_t i = 0; i < 3000; ++i) {
+				parts.push_back("part " + std::to_string(i) + " " + std::string(i % 97, 'x') + "\n");
+			}
+
+			ProducerIovec producer;
+			std::string concatenated = header;
+			producer.add(header);
+			for(const std::string& part : parts) {
+				producer.add(part);
+				concatenated += part;
+			}
+			producer.add(trailer);
+			concatenated += trailer;
+
+			{
+				ConsumerString consumer;
+
+				Process process(Arguments("/usr/bin/cat"));
+				process.setStreamBufferSize(FileDescriptor::stdInHandle, 4096);
+				int rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " size=" << producer.getSize() << " output=" << (consumer.getString() == concatenated ? "equal" : "different") << "\n";
+			}
+
+			{
+				ProcessKey keyIovec((Arguments("/usr/bin/cat")));
+				keyIovec.addInput(producer);
+				ProcessKey keyString((Arguments("/usr/bin/cat")));
+				keyString.addInput(concatenated.data(), concatenated.size());
+				std::cout << "keys " << (keyIovec.getHash() == keyString.getHash() ? "equal" : "different") << "\n";
+			}
+
+			{
+				std::string path = "/tmp/zsystem-testcase-30.tmp";
+				FileDescriptor file = FileDescriptor::openFile(path, true, true, true);
+				unlink(path.c_str());
+
+				file.pwrite("World!", 6, 6);
+				file.pwrite("Hello ", 6, 0);
+
+				char hello[6];
+				char world[6];
+				struct iovec iov[2];
+				iov[0].iov_base = hello;
+				iov[0].iov_len = sizeof(hello);
+				iov[1].iov_base = world;
+				iov[1].iov_len = sizeof(world);
+				std::size_t count = file.readv(iov, 2);
+
+				char check[12];
+				std::size_t checkCount = file.pread(check, sizeof(check), 0);
+				std::cout << "readv=" << count << " \"" << std::string(hello, 6) << std::string(world, 6) << "\""
+						<< " pread=" << checkCount << " \"" << std::string(check, checkCount) << "\"\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_30();
+		}
+		else if(testcase == "31") {
+#ifdef ZSYSTEM_PMR
+			std::string input(1024 * 1024, 'x');
+
+			/* warm up the BufferPool, it is not part of an execution */
+			{
+				ProducerStatic producer(input.data(), input.size());
+				CountingSpanConsumer consumer;
+				Process process(Arguments("/usr/bin/cat"));
+				process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+			}
+
+			for(int useArena = 0; useArena < 2; ++useArena) {
+				alignas(std::max_align_t) static char arenaBuffer[256 * 1024];
+				std::pmr::monotonic_buffer_resource arena(arenaBuffer, sizeof(arenaBuffer), std::pmr::null_memory_resource());
+				MemoryResource* memoryResource = useArena ? &arena : nullptr;
+
+				std::size_t allocations = allocationCount;
+				int rc;
+				{
+					ProducerStatic producer(input.data(), input.size());
+					CountingSpanConsumer consumer;
+
+					Process process(Arguments("/usr/bin/cat", memoryResource));
+					process.setMemoryResource(memoryResource);
+					process.setEnvironment(std::unique_ptr<Environment>(new Environment(Environment::copyCurrent(memoryResource))));
+					rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				}
+				allocations = allocationCount - allocations;
+
+				std::cout << (useArena ? "arena:   " : "default: ") << "rc=" << rc << " global allocations=" << allocations << "\n";
+			}
+#else
+			std::cout << "Build with -DZSYSTEM_PMR=ON to run this testcase.\n";
+#endif
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_31();
+		}
+		else if(testcase == "32") {
+			std::string input(16 * 1024 * 1024, 0);
+			for(std::size_t i = 0; i < input.size(); ++i) {
+				input[i] = static_cast<char>('a' + i % 26);
+			}
+			{
+				std::ofstream file("/tmp/zsystem-splice-input.txt", std::ios::binary);
+				file.write(input.data(), input.size());
+			}
+
+			{
+				std::size_t syscalls = getReadWriteSyscalls();
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.executeStatic(
+						ProducerFile(FileDescriptor::openFile("/tmp/zsystem-splice-input.txt", true, false, false)),
+						ConsumerFile(FileDescriptor::openFile("/tmp/zsystem-splice-output.txt", false, true, true)));
+				syscalls = getReadWriteSyscalls() - syscalls;
+
+				std::cout << "rc=" << rc
+						<< " output=" << (readFile("/tmp/zsystem-splice-output.txt") == input ? "equal" : "different")
+						<< " read/write syscalls=" << syscalls << "\n";
+			}
+
+			{
+				std::pair<FileDescriptor, FileDescriptor> sockets = FileDescriptor::openBidirectional();
+				{
+					std::ofstream file("/tmp/zsystem-splice-input.txt", std::ios::binary);
+					file << "Hello World!";
+				}
+
+				ProducerFile producer(FileDescriptor::openFile("/tmp/zsystem-splice-input.txt", true, false, false));
+				while(producer.produce(sockets.first) != FileDescriptor::npos) { }
+				sockets.first.close();
+
+				ConsumerFile consumer(FileDescriptor::openFile("/tmp/zsystem-splice-output.txt", false, true, true));
+				consumer.consume(sockets.second);
+				consumer.getFileDescriptor().close();
+
+				std::cout << "fallback: \"" << readFile("/tmp/zsystem-splice-output.txt") << "\"\n";
+			}
+
+			std::remove("/tmp/zsystem-splice-input.txt");
+			std::remove("/tmp/zsystem-splice-output.txt");
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_32();
+		}
+		else if(testcase == "33") {
+			std::string input(16 * 1024 * 1024, 0);
+			for(std::size_t i = 0; i < input.size(); ++i) {
+				input[i] = static_cast<char>('a' + i % 26);
+			}
+
+			{
+				/* input must not change until execute() has returned */
+				ProducerStatic producer(input.data(), input.size());
+				producer.setZeroCopy(true);
+				ConsumerString consumer;
+
+				Process process(Arguments("/usr/bin/cat"));
+				int rc = process.execute(producer, FileDescriptor::stdInHandle, consumer, FileDescriptor::stdOutHandle);
+				std::cout << "rc=" << rc << " output=" << (consumer.getString() == input ? "equal" : "different")
+						<< " zero copy=" << (producer.isZeroCopy() ? "true" : "false") << "\n";
+			}
+
+			{
+				std::pair<FileDescriptor, FileDescriptor> sockets = FileDescriptor::openBidirectional();
+				std::string hello = "Hello World!";
+				ProducerStatic producer(hello.data(), hello.size());
+				producer.setZeroCopy(true);
+				while(producer.produce(sockets.first) != FileDescriptor::npos) { }
+				sockets.first.close();
+
+				char buffer[64];
+				std::size_t count = sockets.second.read(buffer, sizeof(buffer));
+				std::cout << "fallback: \"" << std::string(buffer, count == FileDescriptor::npos ? 0 : count) << "\""
+						<< " zero copy=" << (producer.isZeroCopy() ? "true" : "false") << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_33();
+		}
+		else if(testcase == "34") {
+			std::string input(100 * 1024 * 1024 + 123, 0);
+			for(std::size_t i = 0; i < input.size(); ++i) {
+				input[i] = static_cast<char>('a' + i % 26);
+			}
+			{
+				std::ofstream file("/tmp/zsystem-mmap-input.txt", std::ios::binary);
+				file.write(input.data(), input.size());
+			}
+
+			std::pair<FileDescriptor, FileDescriptor> sockets = FileDescriptor::openBidirectional();
+			std::string output;
+			std::thread reader([&sockets, &output]() {
+				char buffer[65536];
+				while(true) {
+					std::size_t count = sockets.second.read(buffer, sizeof(buffer));
+					if(count == 0 || count == FileDescriptor::npos) {
+						break;
+					}
+					output.append(buffer, count);
+				}
+			});
+
+			{
+				FileDescriptor file = FileDescriptor::openFile("/tmp/zsystem-mmap-input.txt", true, false, false);
+				char skip[5000];
+				file.read(skip, sizeof(skip));
+
+				ProducerFile producer(std::move(file));
+				while(producer.produce(sockets.first) != FileDescriptor::npos) { }
+				sockets.first.close();
+			}
+			reader.join();
+
+			std::cout << "size=" << output.size() << " output=" << (output == input.substr(5000) ? "equal" : "different") << "\n";
+			std::remove("/tmp/zsystem-mmap-input.txt");
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_34();
+		}
+		else if(testcase == "35") {
+			ProducerStatic producer("hello\n", 6);
+			ConsumerString consumer;
+
+			Process::ParameterStreams parameterStreams;
+			parameterStreams[FileDescriptor::stdInHandle].producer = &producer;
+			parameterStreams[FileDescriptor::stdInHandle].consumer = &consumer;
+			Process::ParameterFeatures parameterFeatures;
+
+			Process process(Arguments("/bin/sh -c read\\ line;echo\\ got\\ $line>&0"));
+			int rc = process.execute(parameterStreams, parameterFeatures);
+			std::cout << "rc=" << rc << " output=" << (consumer.getString() == "got hello\n" ? "ok" : "wrong") << "\n";
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_35();
+		}
+		else if(testcase == "36") {
+			class FeatureThrowOnSpawn : public Feature {
+			public:
+				void onSpawn(pid_t pid, FileDescriptor::Handle) override {
+					spawnedPid = pid;
+					throw std::runtime_error("onSpawn failed");
+				}
+
+				pid_t spawnedPid = 0;
+			};
+
+			Process process(Arguments("/usr/bin/sleep 0.5"));
+			FeatureThrowOnSpawn featureThrowOnSpawn;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			try {
+				process.execute(featureThrowOnSpawn);
+				std::cout << "no exception\n";
+			}
+			catch(const std::exception& e) {
+				std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				bool reaped = kill(featureThrowOnSpawn.spawnedPid, 0) == -1 && errno == ESRCH;
+				std::cout << "exception: " << e.what() << " reaped=" << reaped << " after " << elapsed.count() << "ms\n";
+			}
+
+			try {
+				std::cout << "rc=" << process.execute() << "\n";
+			}
+			catch(const std::exception& e) {
+				std::cout << "exception: " << e.what() << "\n";
+			}
+
+			std::cout << "\n\nExecuted testcase:\n";
+			printTestcase_36();
+		}
 		else {
 			printUsage();
 		}